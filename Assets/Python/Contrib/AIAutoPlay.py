@@ -347,10 +347,13 @@ class AIAutoPlay :
 			if self.bBenchmark: # advc
 				self.benchmarkStartTime = time.clock()
 		if self.bBenchmark: # advc
+			seed = -1 # advc.003o: Keep the seed
 			if( popupReturn.getEditBoxString(1) != '' ) :
 				seed = int(popupReturn.getEditBoxString(1))
-				# advc: CvRandom::reseed isn't exposed to Python, but init does the same thing.
-				gc.getGame().getSorenRand().init(seed)
+			# <advc.003o> Reseeds and records per-turn timings
+			if self.numTurns > 0:
+				game.startAutoPlayBenchmark(self.numTurns, seed)
+			return # </advc.003o>
 		# </BM1>
 		if( self.numTurns > 0 ) :
 			if( self.LOG_DEBUG ) : CyInterface().addImmediateMessage("Fully automating for %d turns"%(self.numTurns),"")
@@ -364,7 +367,9 @@ class AIAutoPlay :
 		timeElapsed = benchmarkEndTime - self.benchmarkStartTime	
 		popupInfo = PyPopup.PyPopup(game.getActivePlayer())
 		popupInfo.setHeaderString('Benchmark complete!') # advc: Put this in the header
-		popupInfo.setBodyString('Elapsed time: ' + str(timeElapsed) + ' seconds. turns: ' + str(self.numTurns))	
+		popupInfo.setBodyString('Elapsed time: ' + str(timeElapsed) + ' seconds. turns: ' + str(self.numTurns)
+				# advc.003o:
+				+ '\nPer-turn timings: Logs\\AutoPlayBenchmark.csv')
 		popupInfo.launch(true, PopupStates.POPUPSTATE_QUEUED)
 	# </BM1>
 
@@ -0,0 +1,240 @@
+// advc.003o: New file; see comment in header.
+
+#include "CvGameCoreDLL.h"
+#include "AutoPlayBenchmark.h"
+#include "CvGame.h"
+
+AutoPlayBenchmark* AutoPlayBenchmark::m_pInstance = NULL;
+
+namespace
+{
+	char const* const szLOG_FILE = "AutoPlayBenchmark.csv";
+	int const iTOP_PROFILE_SECTIONS = 30;
+}
+
+
+void AutoPlayBenchmark::start(int iTurns, int iSeed)
+{
+	CvGame& kGame = GC.getGame();
+	if (iTurns <= 0 || kGame.isNetworkMultiPlayer())
+	{
+		FErrorMsg("Benchmark requires a positive number of turns and a local game");
+		return;
+	}
+	SAFE_DELETE(m_pInstance);
+	if (iSeed >= 0)
+	{
+		kGame.getSorenRand().reseed(iSeed);
+		kGame.getMapRand().reseed(iSeed);
+	}
+	m_pInstance = new AutoPlayBenchmark(iTurns, iSeed);
+	kGame.setAIAutoPlay(iTurns);
+}
+
+
+void AutoPlayBenchmark::end()
+{
+	if (m_pInstance == NULL)
+		return;
+	m_pInstance->charge(now());
+	m_pInstance->writeSummary();
+	SAFE_DELETE(m_pInstance);
+}
+
+
+AutoPlayBenchmark::AutoPlayBenchmark(int iTurns, int iSeed)
+:	m_iTurns(iTurns), m_iSeed(iSeed), m_bInUpdate(false),
+	m_eTurnPlayer(NO_PLAYER), m_iTurnsRecorded(0),
+	m_aiTurnTime(MAX_PLAYERS + 1, 0), m_aiTotalTime(MAX_PLAYERS + 1, 0)
+{
+	LARGE_INTEGER freq;
+	QueryPerformanceFrequency(&freq);
+	m_iFrequency = freq.QuadPart;
+	m_iStartTime = m_iTurnStartTime = m_iLastCharged = now();
+	CvGame const& kGame = GC.getGame();
+	m_iGameTurn = m_iStartGameTurn = kGame.getGameTurn();
+	for (int i = 0; i < MAX_PLAYERS; i++)
+	{
+		if (GET_PLAYER((PlayerTypes)i).isTurnActive())
+		{
+			m_eTurnPlayer = (PlayerTypes)i;
+			break;
+		}
+	}
+#ifdef USE_INTERNAL_PROFILER
+	for (int i = 0; i < IFPNumSamples(); i++)
+	{
+		ProfileSample const& kSample = *IFPGetSample(i);
+		ProfileTotals kTotals;
+		kTotals.iTime = kSample.Accumulator.QuadPart;
+		kTotals.iChildTime = kSample.ChildrenSampleTime.QuadPart;
+		kTotals.uiCalls = kSample.ProfileInstances;
+		m_aInitialProfile.push_back(kTotals);
+	}
+#endif
+	writeHeader();
+}
+
+
+LONGLONG AutoPlayBenchmark::now()
+{
+	LARGE_INTEGER time;
+	QueryPerformanceCounter(&time);
+	return time.QuadPart;
+}
+
+
+double AutoPlayBenchmark::toMillis(LONGLONG iTicks) const
+{
+	return (1000.0 * iTicks) / m_iFrequency;
+}
+
+// Attribute the time since the last call to the current turn player
+void AutoPlayBenchmark::charge(LONGLONG iNow)
+{
+	if (!m_bInUpdate)
+		return;
+	int const iIndex = (m_eTurnPlayer == NO_PLAYER ? MAX_PLAYERS : m_eTurnPlayer);
+	m_aiTurnTime[iIndex] += iNow - m_iLastCharged;
+	m_iLastCharged = iNow;
+}
+
+
+void AutoPlayBenchmark::beginUpdate()
+{
+	m_bInUpdate = true;
+	m_iLastCharged = now();
+}
+
+
+void AutoPlayBenchmark::endUpdate()
+{
+	charge(now());
+	m_bInUpdate = false;
+}
+
+
+void AutoPlayBenchmark::beginGameTurn()
+{
+	LONGLONG const iNow = now();
+	charge(iNow);
+	writeTurn(iNow);
+	m_iTurnStartTime = iNow;
+	m_iGameTurn = GC.getGame().getGameTurn();
+	m_eTurnPlayer = NO_PLAYER;
+}
+
+
+void AutoPlayBenchmark::beginPlayerTurn(PlayerTypes ePlayer)
+{
+	charge(now());
+	m_eTurnPlayer = ePlayer;
+}
+
+
+void AutoPlayBenchmark::writeLine(CvString const& szLine)
+{
+	gDLL->logMsg(szLOG_FILE, (szLine + "\n").c_str(), false, false);
+}
+
+
+void AutoPlayBenchmark::writeHeader()
+{
+	CvGame const& kGame = GC.getGame();
+	CvMap const& kMap = GC.getMap();
+	writeLine(CvString::format("# benchmark,turns=%d,seed=%d,start_turn=%d,"
+			"map=%dx%d,players=%d,bulk_moves=%d",
+			m_iTurns, m_iSeed, m_iGameTurn, kMap.getGridWidth(), kMap.getGridHeight(),
+			kGame.countCivPlayersAlive(), kGame.isBulkAIMoves() ? 1 : 0));
+	CvString szHeader("turn,wall_ms,dll_ms,game_ms");
+	for (int i = 0; i < MAX_PLAYERS; i++)
+		szHeader.append(CvString::format(",p%d_ms", i));
+	writeLine(szHeader);
+}
+
+
+void AutoPlayBenchmark::writeTurn(LONGLONG iNow)
+{
+	LONGLONG iDLLTime = 0;
+	for (size_t i = 0; i < m_aiTurnTime.size(); i++)
+	{
+		iDLLTime += m_aiTurnTime[i];
+		m_aiTotalTime[i] += m_aiTurnTime[i];
+	}
+	CvString szLine(CvString::format("%d,%.1f,%.1f,%.1f", m_iGameTurn,
+			toMillis(iNow - m_iTurnStartTime), toMillis(iDLLTime),
+			toMillis(m_aiTurnTime[MAX_PLAYERS])));
+	for (int i = 0; i < MAX_PLAYERS; i++)
+		szLine.append(CvString::format(",%.1f", toMillis(m_aiTurnTime[i])));
+	writeLine(szLine);
+	m_iTurnsRecorded++;
+	std::fill(m_aiTurnTime.begin(), m_aiTurnTime.end(), 0);
+}
+
+
+void AutoPlayBenchmark::writeSummary()
+{
+	LONGLONG const iNow = now();
+	// Remainder of the last turn (normally just the start of a turn)
+	if (iNow > m_iTurnStartTime)
+		writeTurn(iNow);
+	LONGLONG iDLLTime = 0;
+	for (size_t i = 0; i < m_aiTotalTime.size(); i++)
+		iDLLTime += m_aiTotalTime[i];
+	double const dWallTime = toMillis(iNow - m_iStartTime);
+	// Game turns completed (the first row is normally only a partial turn)
+	int const iGameTurns = GC.getGame().getGameTurn() - m_iStartGameTurn;
+	writeLine(CvString::format("# total,rows=%d,wall_ms=%.1f,dll_ms=%.1f,game_ms=%.1f,"
+			"avg_wall_ms=%.1f,turns_per_min=%.2f", m_iTurnsRecorded, dWallTime,
+			toMillis(iDLLTime), toMillis(m_aiTotalTime[MAX_PLAYERS]),
+			dWallTime / std::max(1, m_iTurnsRecorded),
+			(60000.0 * iGameTurns) / std::max(1.0, dWallTime)));
+	CvString szPlayers("# total_players");
+	for (int i = 0; i < MAX_PLAYERS; i++)
+		szPlayers.append(CvString::format(",%.1f", toMillis(m_aiTotalTime[i])));
+	writeLine(szPlayers);
+	writeProfile();
+}
+
+
+void AutoPlayBenchmark::writeProfile()
+{
+#ifdef USE_INTERNAL_PROFILER
+	if (GC.isDLLProfilerEnabled())
+	{	// startProfilingDLL resets the totals on every update
+		writeLine("# profile,unavailable (DLL profiler is enabled)");
+		return;
+	}
+	// (inclusive time, sample id)
+	std::vector<std::pair<LONGLONG,int> > aiSections;
+	for (int i = 0; i < IFPNumSamples(); i++)
+	{
+		ProfileSample const& kSample = *IFPGetSample(i);
+		LONGLONG iTime = kSample.Accumulator.QuadPart;
+		if (i < (int)m_aInitialProfile.size())
+			iTime -= m_aInitialProfile[i].iTime;
+		if (iTime > 0)
+			aiSections.push_back(std::make_pair(iTime, i));
+	}
+	std::sort(aiSections.begin(), aiSections.end(),
+			std::greater<std::pair<LONGLONG,int> >());
+	writeLine("# section,calls,incl_ms,excl_ms");
+	for (int i = 0; i < std::min(iTOP_PROFILE_SECTIONS, (int)aiSections.size()); i++)
+	{
+		int const iId = aiSections[i].second;
+		ProfileSample const& kSample = *IFPGetSample(iId);
+		LONGLONG iChildTime = kSample.ChildrenSampleTime.QuadPart;
+		unsigned int uiCalls = kSample.ProfileInstances;
+		if (iId < (int)m_aInitialProfile.size())
+		{
+			iChildTime -= m_aInitialProfile[iId].iChildTime;
+			uiCalls -= m_aInitialProfile[iId].uiCalls;
+		}
+		writeLine(CvString::format("\"%s\",%u,%.1f,%.1f", kSample.Name, uiCalls,
+				toMillis(aiSections[i].first),
+				toMillis(aiSections[i].first - iChildTime)));
+	}
+#else
+	writeLine("# profile,unavailable (build without USE_INTERNAL_PROFILER)");
+#endif
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#ifndef AUTO_PLAY_BENCHMARK_H
+#define AUTO_PLAY_BENCHMARK_H
+
+/*	advc.003o: Records timings during AI Auto Play so that the turn times of
+	different builds can be compared. Started through CyGame::startAutoPlayBenchmark
+	(Ctrl+Shift+B in AIAutoPlay.py), which also fixes the seed of the synchronized RNG.
+	For comparable results, start from the same savegame (same map size, same
+	players) with the same seed and number of turns.
+
+	Writes AutoPlayBenchmark.csv to the Logs folder (LoggingEnabled=1 in
+	CivilizationIV.ini): one row per game turn with the wall time, the time spent
+	in the DLL (CvGame::update), the time spent on game-level turn processing and
+	the time spent on each player's turn - all in milliseconds. The first row
+	covers only the remainder of the turn in which the benchmark was started.
+	At the end: totals and, in builds with the internal profiler, the PROFILE
+	sections with the highest inclusive times since the benchmark started.
+	The turns per minute in the summary allow comparing runs with and without
+	BULK_AI_MOVES (GlobalDefines_devel.xml); the header records that setting.
+	The EXE owns the frame loop, so rendering can't be turned off from here; time
+	spent outside of CvGame::update only counts toward the wall time. */
+class AutoPlayBenchmark : private boost::noncopyable
+{
+public:
+	// iSeed < 0 keeps the current seed
+	static void start(int iTurns, int iSeed);
+	static inline AutoPlayBenchmark* getInstance() { return m_pInstance; }
+	static void end(); // Writes the summary; no-op if no benchmark is running.
+	// Event hooks ...
+	void beginUpdate();
+	void endUpdate();
+	void beginGameTurn();
+	void beginPlayerTurn(PlayerTypes ePlayer);
+
+private:
+	static AutoPlayBenchmark* m_pInstance;
+	AutoPlayBenchmark(int iTurns, int iSeed);
+
+	LONGLONG m_iFrequency;
+	LONGLONG m_iStartTime;
+	LONGLONG m_iTurnStartTime;
+	LONGLONG m_iLastCharged;
+	bool m_bInUpdate;
+	PlayerTypes m_eTurnPlayer; // NO_PLAYER for game-level turn processing
+	int m_iTurns;
+	int m_iSeed;
+	int m_iGameTurn;
+	int m_iStartGameTurn;
+	int m_iTurnsRecorded;
+	// Per turn (index MAX_PLAYERS is game-level processing)
+	std::vector<LONGLONG> m_aiTurnTime;
+	std::vector<LONGLONG> m_aiTotalTime;
+
+	struct ProfileTotals
+	{
+		LONGLONG iTime;
+		LONGLONG iChildTime;
+		unsigned int uiCalls;
+	};
+	std::vector<ProfileTotals> m_aInitialProfile;
+
+	static LONGLONG now();
+	double toMillis(LONGLONG iTicks) const;
+	void charge(LONGLONG iNow);
+	void writeHeader();
+	void writeTurn(LONGLONG iNow);
+	void writeSummary();
+	void writeProfile();
+	static void writeLine(CvString const& szLine);
+};
+
+#endif
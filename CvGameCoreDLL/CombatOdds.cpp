@@ -539,10 +539,88 @@ int LFBlookupCombatOdds(LFBoddsFirstStrike* pOdds, int iFSIndex, int iFirstStrik
 	return iOdds;
 }
 
+/*	advc.opt: Flat replacement for the nested vectors above, covering all
+	sub-results that can occur with the combat defines of the current mod -
+	apart from first-strike differences beyond MAX_FS. Allocated in full by
+	combat_odds::initOddsTable; the entries still get computed on first use.
+	Sub-results outside of that range continue to use the nested vectors,
+	so that the results are exactly the same either way. */
+class LFBOddsTable
+{
+public:
+	static int const MAX_FS = 8;
+
+	LFBOddsTable() : m_iMaxRounds(0), m_iOddsIndices(0) {}
+
+	void init(int iMaxRounds, int iOddsIndices)
+	{
+		m_iMaxRounds = iMaxRounds;
+		m_iOddsIndices = iOddsIndices;
+		m_aiOdds.assign((2 * MAX_FS + 1) * iMaxRounds * iMaxRounds * iOddsIndices,
+				NOT_COMPUTED);
+	}
+
+	bool isInitialized() const { return !m_aiOdds.empty(); }
+
+	// Covers the interval boundaries on both sides of iAttackerOdds?
+	bool isInRange(int iFirstStrikes, int iNeededRoundsAttacker,
+		int iNeededRoundsDefender, int iAttackerOdds) const
+	{
+		return (abs(iFirstStrikes) <= MAX_FS &&
+				iNeededRoundsAttacker <= m_iMaxRounds &&
+				iNeededRoundsDefender <= m_iMaxRounds &&
+				iAttackerOdds / LFB_ODDS_INTERVAL_SIZE + 1 < m_iOddsIndices);
+	}
+
+	// Same as LFBlookupCombatOdds(LFBoddsAttOdds*, ...)
+	int lookup(int iFirstStrikes, int iNeededRoundsAttacker,
+		int iNeededRoundsDefender, int iOddsIndex)
+	{
+		// Index==0 => AttackerOdds==0 => no chance to win
+		if (iOddsIndex == 0)
+			return 0;
+		int& iOdds = m_aiOdds[(((iFirstStrikes + MAX_FS) * m_iMaxRounds +
+				iNeededRoundsAttacker - 1) * m_iMaxRounds +
+				iNeededRoundsDefender - 1) * m_iOddsIndices + iOddsIndex];
+		if (iOdds == NOT_COMPUTED)
+		{
+			iOdds = LFBcalculateCombatOdds(iFirstStrikes, iNeededRoundsAttacker,
+					iNeededRoundsDefender, iOddsIndex * LFB_ODDS_INTERVAL_SIZE);
+		}
+		return iOdds;
+	}
+
+private:
+	static int const NOT_COMPUTED = -1;
+	int m_iMaxRounds;
+	int m_iOddsIndices;
+	vector<int> m_aiOdds;
+};
+LFBOddsTable oddsTable;
+
 // lookup the combat odds in the cache for a specific sub-result
 int LFBlookupCombatOdds(int iFirstStrikes, int iNeededRoundsAttacker,
 	int iNeededRoundsDefender, int iAttackerOdds)
 {
+	// <advc.opt>
+	FAssertMsg(oddsTable.isInitialized(), "combat_odds::initOddsTable not called");
+	if (oddsTable.isInRange(iFirstStrikes, iNeededRoundsAttacker,
+		iNeededRoundsDefender, iAttackerOdds))
+	{	// Same interpolation as in LFBlookupCombatOdds(LFBoddsFirstStrike*, ...)
+		int const iMinOddsIndex = iAttackerOdds / LFB_ODDS_INTERVAL_SIZE;
+		int const iMinOddsValue = iMinOddsIndex * LFB_ODDS_INTERVAL_SIZE;
+		int iOdds = oddsTable.lookup(iFirstStrikes, iNeededRoundsAttacker,
+				iNeededRoundsDefender, iMinOddsIndex);
+		if (iMinOddsValue < iAttackerOdds)
+		{
+			int const iMaxOdds = oddsTable.lookup(iFirstStrikes, iNeededRoundsAttacker,
+					iNeededRoundsDefender, iMinOddsIndex + 1);
+			iOdds += intdiv::uround(
+					(iAttackerOdds - iMinOddsValue) * (iMaxOdds - iOdds),
+					LFB_ODDS_INTERVAL_SIZE);
+		}
+		return iOdds;
+	} // </advc.opt>
 	int iOdds = 0;
 	/*	We actually maintain two caches - one for positive first strikes (plus zero)
 		and one for negative.
@@ -680,6 +758,20 @@ int estimateCombatOdds(CvUnit const& kAttacker, CvUnit const& kDefender, int iSa
 #endif // MONTE_CARLO_ODDS_TEST
 } // (end of unnamed namespace)
 
+/*	advc.opt: The LFB sub-results are only needed for the odds of the side
+	that is less likely to land a hit, i.e. at most half the die sides.
+	Hits to win are largest when firepower is lopsided; then the weaker side
+	deals about a third of COMBAT_DAMAGE per hit (see setupCombatantsImpl).
+	Capped so that mods with tiny COMBAT_DAMAGE don't get a huge table. */
+void combat_odds::initOddsTable()
+{
+	int const iMinDamagePerRound = std::max(1, GC.getCOMBAT_DAMAGE() / 3);
+	int const iMaxRounds = std::min(40, intdiv::uceil(
+			GC.getMAX_HIT_POINTS(), iMinDamagePerRound));
+	int const iOddsIndices = GC.getCOMBAT_DIE_SIDES() / 2 / LFB_ODDS_INTERVAL_SIZE + 2;
+	oddsTable.init(std::max(1, iMaxRounds), iOddsIndices);
+}
+
 // Unlike setupCombatants, this is guaranteed to initialize the combatants.
 void combat_odds::initCombatants(CvUnit const& kAttacker, CvUnit const& kDefender,
 	Combatant& att, Combatant& def, bool bHideFreeWins)
@@ -13,6 +13,9 @@ int calculateCombatOdds(CvUnit const& kAttacker, CvUnit const& kDefender); // Ex
 // <advc>
 namespace combat_odds
 {
+/*	advc.opt: Allocates the memo table for the odds calculation based on the
+	combat defines. Called at the start of each game. */
+void initOddsTable();
 class Combatant;
 void initCombatants(CvUnit const& kAttacker, CvUnit const& kDefender,
 		Combatant& att, Combatant& def, bool bHideFreeWins);
@@ -15,6 +15,8 @@
 #include "CvBugOptions.h" // advc.060
 #include "BBAILog.h" // BETTER_BTS_AI_MOD, AI logging, 10/02/09, jdog5000
 
+int CvCity::m_iTradeProfitEpoch = 0; // advc.opt
+
 
 CvCity::CvCity() // advc.003u: Merged with the deleted reset function
 {
@@ -136,6 +138,9 @@ CvCity::CvCity() // advc.003u: Merged with the deleted reset function
 	// Rank cache
 	m_iPopulationRank = -1;
 	m_bPopulationRankValid = false;
+	// <advc.opt>
+	m_tradeProfitCache.clear();
+	m_iTradeProfitCacheEpoch = -1; // </advc.opt>
 }
 
 CvCity::~CvCity() // advc.003u: Merged with the deleted uninit function
@@ -159,6 +164,7 @@ void CvCity::init(int iID, PlayerTypes eOwner, int iX, int iY, bool bBumpUnits,
 	m_iY = iY;
 	// </advc.003u>
 	updatePlot(); // advc.opt
+	invalidateTradeProfits(); // advc.opt
 	setupGraphical();
 
 	CvPlayer& kOwner = GET_PLAYER(getOwner());
@@ -302,6 +308,7 @@ void CvCity::reloadEntity()
 void CvCity::kill(bool bUpdatePlotGroups, /* advc.001: */ bool bBumpUnits)
 {
 	CvPlot& kPlot = *plot();
+	invalidateTradeProfits(); // advc.opt
 
 	if (isCitySelected())
 		gDLL->UI().clearSelectedCities();
@@ -4463,6 +4470,8 @@ void CvCity::setPopulation(int iNewValue)
 
 	m_iPopulation = iNewValue;
 	FAssert(getPopulation() >= 0);
+	invalidateTradeProfits(); // advc.opt
+	GC.getMap().setFoundValuesDirty(getPlot()); // advc.opt
 	GET_PLAYER(getOwner()).invalidatePopulationRankCache();
 	if (getPopulation() > getHighestPopulation())
 		setHighestPopulation(getPopulation());
@@ -4540,6 +4549,7 @@ void CvCity::changeSpecialistPopulation(int iChange)
 	{
 		m_iSpecialistPopulation += iChange;
 		FAssert(getSpecialistPopulation() >= 0);
+		GC.getMap().setFoundValuesDirty(getPlot()); // advc.opt
 		GET_PLAYER(getOwner()).invalidateYieldRankCache();
 		updateCommerce();
 	}
@@ -6021,6 +6031,7 @@ void CvCity::changeTradeRouteModifier(int iChange)
 	if (iChange != 0)
 	{
 		m_iTradeRouteModifier += iChange;
+		invalidateTradeProfits(); // advc.opt
 		updateTradeRoutes();
 	}
 }
@@ -6031,6 +6042,7 @@ void CvCity::changeForeignTradeRouteModifier(int iChange)
 	if (iChange != 0)
 	{
 		m_iForeignTradeRouteModifier += iChange;
+		invalidateTradeProfits(); // advc.opt
 		updateTradeRoutes();
 	}
 }
@@ -6058,6 +6070,7 @@ void CvCity::changeBuildingDefense(int iChange)
 	{
 		m_iBuildingDefense += iChange;
 		FAssert(getBuildingDefense() >= 0);
+		CvPlayerAI::AI_invalidateCombatCache(); // advc.opt
 		setInfoDirty(true);
 		getPlot().plotAction(PUF_makeInfoBarDirty);
 	}
@@ -6199,6 +6212,7 @@ void CvCity::changeDefenseDamage(int iChange)
 	if (iChange == 0)
 		return;
 	m_iDefenseDamage = range(m_iDefenseDamage + iChange, 0, GC.getMAX_CITY_DEFENSE_DAMAGE());
+	CvPlayerAI::AI_invalidateCombatCache(); // advc.opt
 	if (iChange > 0)
 		setBombarded(true);
 	setInfoDirty(true);
@@ -6485,6 +6499,8 @@ bool CvCity::isInfoDirty() const
 void CvCity::setInfoDirty(bool bNewValue)
 {
 	m_bInfoDirty = bNewValue;
+	if (bNewValue) // advc.opt
+		CvGameTextMgr::invalidateHelpTextCache();
 }
 
 
@@ -6543,6 +6559,7 @@ void CvCity::setCultureLevel(CultureLevelTypes eNewValue, bool bUpdatePlotGroups
 		return;
 
 	m_eCultureLevel = eNewValue;
+	GC.getMap().setFoundValuesDirty(getPlot(), true); // advc.opt
 	if (eOldValue != NO_CULTURELEVEL)
 	{
 		for (int iDX = -eOldValue; iDX <= eOldValue; iDX++)
@@ -7093,9 +7110,20 @@ int CvCity::getBaseTradeProfit(CvCity const* pCity) const // advc: const CvCity*
 
 int CvCity::calculateTradeProfitTimes100(CvCity const* pCity) const // advc: const CvCity*
 {
+	// <advc.opt>
+	if (m_iTradeProfitCacheEpoch != m_iTradeProfitEpoch)
+	{
+		m_tradeProfitCache.clear();
+		m_iTradeProfitCacheEpoch = m_iTradeProfitEpoch;
+	}
+	int const iKey = GC.getMap().plotNum(pCity->getPlot());
+	std::map<int,int>::const_iterator itCached = m_tradeProfitCache.find(iKey);
+	if (itCached != m_tradeProfitCache.end())
+		return itCached->second; // </advc.opt>
 	int iProfit = getBaseTradeProfit(pCity);
 	iProfit *= totalTradeModifier(pCity);
 	iProfit /= /*10000*/100; // advc.004: Increase precision; function renamed accordingly.
+	m_tradeProfitCache[iKey] = iProfit; // advc.opt
 	return iProfit;
 }
 
@@ -8785,6 +8813,7 @@ void CvCity::setWorkingPlot(CityPlotTypes ePlot, bool bNewValue) // advc.enum: C
 	CvPlot* pPlot = getCityIndexPlot(ePlot);
 	if (pPlot != NULL)
 	{
+		GC.getMap().setFoundValuesDirty(*pPlot); // advc.opt
 		FAssertMsg(pPlot->getWorkingCity() == this, "WorkingCity is expected to be this");
 
 		if (isWorkingPlot(ePlot))
@@ -9463,8 +9492,29 @@ void CvCity::clearTradeRoutes()
 	}
 }
 
+// advc.opt:
+bool CvCity::isIgnorePlotGroupsForTradeRoutes()
+{
+	static bool const bIgnorePlotGroups = (GC.getDefineBOOL("IGNORE_PLOT_GROUP_FOR_TRADE_ROUTES"));
+	return bIgnorePlotGroups;
+}
+
 // XXX eventually, this needs to be done when roads are built/destroyed...
 void CvCity::updateTradeRoutes()  // advc: refactored
+{
+	// <advc.opt> Partner cities moved into CvPlayer::getTradeRouteCandidates
+	CvPlayer::TradeRouteCandidates candidates;
+	if (!isDisorder() && !isPlundered())
+		GET_PLAYER(getOwner()).getTradeRouteCandidates(candidates);
+	CvPlayer::TradeRouteCandidates::const_iterator itCandidates = candidates.find(
+			isIgnorePlotGroupsForTradeRoutes() ? NULL : plotGroup(getOwner()));
+	if (itCandidates == candidates.end())
+		updateTradeRoutes(std::vector<CvCity*>());
+	else updateTradeRoutes(itCandidates->second); // </advc.opt>
+}
+
+
+void CvCity::updateTradeRoutes(std::vector<CvCity*> const& kCandidates) // advc.opt
 {
 	int const iMaxTradeRoutes = GC.getDefineINT(CvGlobals::MAX_TRADE_ROUTES);
 	CvPlayer const& kOwner = GET_PLAYER(getOwner());
@@ -9475,49 +9525,33 @@ void CvCity::updateTradeRoutes()  // advc: refactored
 	{
 		int iTradeRoutes = getTradeRoutes();
 		FAssert(iTradeRoutes <= (int)m_aTradeCities.size()); // advc
-		static bool const bIgnorePlotGroups = (GC.getDefineBOOL("IGNORE_PLOT_GROUP_FOR_TRADE_ROUTES")); // advc.opt
 		int* aiBestValue = new int[iMaxTradeRoutes](); // value-initialize
-		for (PlayerIter<MAJOR_CIV> it; it.hasNext(); ++it)
+		for (size_t iCandidate = 0; iCandidate < kCandidates.size(); iCandidate++)
 		{
-			CvPlayer const& kPartner = *it;
-			if(!kOwner.canHaveTradeRoutesWith(kPartner.getID()))
+			CvCity* pLoopCity = kCandidates[iCandidate];
+			if(pLoopCity == this)
 				continue;
-
-			FOR_EACH_CITY(pLoopCity, kPartner)
+			if(pLoopCity->isTradeRoute(kOwner.getID()) &&
+				getTeam() != pLoopCity->getTeam())
 			{
-				if(pLoopCity == this)
-					continue;
-				/*  <advc.124> A connection along revealed tiles ensures that the
-					city tile is revealed, but not that the city is revealed. */
-				if(pLoopCity->isDisorder() || !pLoopCity->isRevealed(getTeam()))
-					continue; // <advc.124>
-				if(pLoopCity->isTradeRoute(kOwner.getID()) &&
-					getTeam() != kPartner.getTeam())
-				{
-					continue;
-				}
-				if(!bIgnorePlotGroups &&
-					pLoopCity->plotGroup(kOwner.getID()) != plotGroup(kOwner.getID()))
-				{
+				continue;
+			}
+			/*	advc: Times 100 so that there are fewer ties (which, currently,
+				are broken arbitrarily based on player and city id). */
+			int iValue = calculateTradeProfitTimes100(pLoopCity);
+			for (int i = 0; i < iTradeRoutes; i++)
+			{
+				if(iValue <= aiBestValue[i])
 					continue;
-				}
-				/*	advc: Times 100 so that there are fewer ties (which, currently,
-					are broken arbitrarily based on player and city id). */
-				int iValue = calculateTradeProfitTimes100(pLoopCity);
-				for (int i = 0; i < iTradeRoutes; i++)
+				for (int j = iTradeRoutes - 1; j > i; j--)
 				{
-					if(iValue <= aiBestValue[i])
-						continue;
-					for (int j = iTradeRoutes - 1; j > i; j--)
-					{
-						aiBestValue[j] = aiBestValue[j - 1];
-						FAssertBounds(1, m_aTradeCities.size(), j);
-						m_aTradeCities[j] = m_aTradeCities[j - 1];
-					}
-					aiBestValue[i] = iValue;
-					m_aTradeCities[i] = pLoopCity->getIDInfo();
-					break;
+					aiBestValue[j] = aiBestValue[j - 1];
+					FAssertBounds(1, m_aTradeCities.size(), j);
+					m_aTradeCities[j] = m_aTradeCities[j - 1];
 				}
+				aiBestValue[i] = iValue;
+				m_aTradeCities[i] = pLoopCity->getIDInfo();
+				break;
 			}
 		}
 		SAFE_DELETE_ARRAY(aiBestValue);
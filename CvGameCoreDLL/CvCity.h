@@ -745,6 +745,11 @@ public:
 		return calculateTradeProfitTimes100(pCity) / 100;
 	}
 	int calculateTradeProfitTimes100(CvCity const* pCity) const; // advc.004
+	/*	advc.opt: calculateTradeProfitTimes100 is memoized per pair of cities.
+		To be called upon any change of its inputs: population, trade route
+		modifiers, connection to the capital (plot groups, capital), areas,
+		war and peace, turns at peace, elapsed turns, cities founded or lost. */
+	static inline void invalidateTradeProfits() { m_iTradeProfitEpoch++; }
 	int calculateTradeYield(YieldTypes eYield, int iTradeProfit) const;											// Exposed to Python
 	// BULL - Trade Hover - start
 	void calculateTradeTotals(YieldTypes eYield, int& iDomesticYield, int& iDomesticRoutes,
@@ -1152,6 +1157,10 @@ public:
 	int getTradeRoutes() const;																					// Exposed to Python
 	void clearTradeRoutes();
 	void updateTradeRoutes();
+	/*	advc.opt: kCandidates from CvPlayer::getTradeRouteCandidates; the ones
+		in this city's plot group. */
+	void updateTradeRoutes(std::vector<CvCity*> const& kCandidates);
+	static bool isIgnorePlotGroupsForTradeRoutes(); // advc.opt
 
 	void clearOrderQueue();																						// Exposed to Python
 	//void pushOrder(OrderTypes eOrder, int iData1, int iData2, bool bSave, bool bPop, bool bAppend, bool bForce = false);
@@ -1464,6 +1473,12 @@ protected:
 	// Rank cache
 	mutable int	m_iPopulationRank;
 	mutable bool m_bPopulationRankValid;
+	/*	<advc.opt> calculateTradeProfitTimes100 by plot number of the partner
+		city; valid while m_iTradeProfitCacheEpoch equals m_iTradeProfitEpoch.
+		Not serialized. */
+	mutable std::map<int,int> m_tradeProfitCache;
+	mutable int m_iTradeProfitCacheEpoch;
+	static int m_iTradeProfitEpoch; // </advc.opt>
 	// <advc.enum>
 	/*	Made mutable (not strictly necessary b/c findBaseYieldRateRank
 		accesses them through a CvCity pointer) */
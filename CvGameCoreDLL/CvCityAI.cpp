@@ -8009,6 +8009,14 @@ int CvCityAI::AI_countBestBuilds(CvArea const& kArea) const
 void CvCityAI::AI_updateBestBuild()
 {
 	CvPlayerAI& kOwner = GET_PLAYER(getOwner()); // K-Mod
+	/*	<advc.opt> The found values of nearby sites depend on which plots
+		we consider good (AI_isGoodPlot) */
+	BuildTypes aeOldGoodBuild[NUM_CITY_PLOTS];
+	for (CityPlotTypes ePlot = CITY_HOME_PLOT; ePlot < NUM_CITY_PLOTS; ++ePlot)
+	{
+		aeOldGoodBuild[ePlot] = (m_aiBestBuildValue[ePlot] > 50 ?
+				m_aeBestBuild[ePlot] : NO_BUILD);
+	} // </advc.opt>
 
 	int iFoodMultiplier, iProductionMultiplier, iCommerceMultiplier, iDesiredFoodChange;
 	AI_getYieldMultipliers(iFoodMultiplier, iProductionMultiplier, iCommerceMultiplier, iDesiredFoodChange);
@@ -8277,8 +8285,7 @@ void CvCityAI::AI_updateBestBuild()
 
 	//Prune plots which are sub-par.
 	// K-Mod. I've rearranged the following code. But kept most of the original functionality.
-	if (iBestUnworkedPlotValue <= 0)
-		return; // advc
+	if (iBestUnworkedPlotValue > 0) // advc.opt: was an early return
 	{
 		PROFILE("AI_updateBestBuild pruning phase");
 		for (WorkablePlotIter itPlot(*this, false); itPlot.hasNext(); ++itPlot)
@@ -8315,7 +8322,16 @@ void CvCityAI::AI_updateBestBuild()
 				}
 			}
 		}
-	}
+	} // <advc.opt>
+	for (CityPlotTypes ePlot = CITY_HOME_PLOT; ePlot < NUM_CITY_PLOTS; ++ePlot)
+	{
+		if (aeOldGoodBuild[ePlot] != (m_aiBestBuildValue[ePlot] > 50 ?
+			m_aeBestBuild[ePlot] : NO_BUILD))
+		{
+			GC.getMap().setFoundValuesDirty(getPlot());
+			break;
+		}
+	} // </advc.opt>
 }
 
 // advc.129:
@@ -122,6 +122,7 @@ void CvDeal::announceCancel(PlayerTypes eMsgTarget, PlayerTypes eOther,
 void CvDeal::killSilent(bool bKillTeam, bool bUpdateAttitude, // </advc.036>
 	PlayerTypes eCancelPlayer) // advc.130p
 {
+	CvPlayerAI::AI_invalidateTradeValCache(); // advc.opt
 	FOR_EACH_TRADE_ITEM(getFirstList())
 	{
 		endTrade(*pItem, getFirstPlayer(), getSecondPlayer(), bKillTeam,
@@ -792,11 +793,20 @@ bool CvDeal::startTrade(TradeData trade, PlayerTypes eFromPlayer, PlayerTypes eT
 	{
 		PROFILE("CvDeal::startTrade.MAPS"); // advc
 		CvMap const& kMap = GC.getMap();
-		for (int i = 0; i < kMap.numPlots(); i++)
+		// <advc.opt> Skip blocks of plots that the giving team hasn't revealed
+		PlotVisibility const& kVisibility = kMap.getVisibility();
+		int const iBlockSize = PlotVisibility::BLOCK_SIZE;
+		for (int iBlock = 0; iBlock < kVisibility.numBlocks(); iBlock++)
 		{
-			CvPlot& kPlot = kMap.getPlotByIndex(i);
-			if (kPlot.isRevealed(TEAMID(eFromPlayer)))
-				kPlot.setRevealed(TEAMID(eToPlayer), true, false, TEAMID(eFromPlayer), false);
+			if (kVisibility.isRevealedBlock(TEAMID(eFromPlayer), iBlock, false))
+				continue;
+			int const iEnd = std::min(kMap.numPlots(), (iBlock + 1) * iBlockSize);
+			for (int i = iBlock * iBlockSize; i < iEnd; i++) // </advc.opt>
+			{
+				CvPlot& kPlot = kMap.getPlotByIndex(i);
+				if (kPlot.isRevealed(TEAMID(eFromPlayer)))
+					kPlot.setRevealed(TEAMID(eToPlayer), true, false, TEAMID(eFromPlayer), false);
+			}
 		}
 		for (MemberIter it(TEAMID(eToPlayer)); it.hasNext(); ++it)
 		{
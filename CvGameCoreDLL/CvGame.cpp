@@ -5,6 +5,7 @@
 #include "CoreAI.h"
 #include "CvCityAI.h"
 #include "CvUnit.h"
+#include "CombatOdds.h" // advc.opt
 #include "CvSelectionGroupAI.h"
 #include "CitySiteEvaluator.h"
 #include "PlotRange.h"
@@ -25,6 +26,7 @@
 #include "RiseFall.h" // advc.700
 #include "CvHallOfFameInfo.h" // advc.106i
 #include "BBAILog.h" // BBAI
+#include "AutoPlayBenchmark.h" // advc.003o
 #include "CvBugOptions.h" // K-Mod
 
 /*	<advc.007b> Use this CvGame instance instead of GC.getGame() for RNG calls.
@@ -697,7 +699,11 @@ void CvGame::reset(HandicapTypes eHandicap, bool bConstructorCall)
 	m_bScenario = false; // advc.052
 
 	if (!bConstructorCall)
+	{
 		AI().AI_reset();
+		combat_odds::initOddsTable(); // advc.opt
+		CvGameTextMgr::invalidateHelpTextCache(); // advc.opt
+	}
 
 	m_ActivePlayerCycledGroups.clear(); // K-Mod
 	m_bInBetweenTurns = false; // advc.106b
@@ -2885,6 +2891,9 @@ bool CvGame::isWeakStartingFoodBonus(CvPlot const& kPlot, PlayerTypes eStartPlay
 void CvGame::update()
 {
 	startProfilingDLL(false);
+	// <advc.003o>
+	if (AutoPlayBenchmark::getInstance() != NULL)
+		AutoPlayBenchmark::getInstance()->beginUpdate(); // </advc.003o>
 	PROFILE_BEGIN("CvGame::update");
 
 	if (!gDLL->GetWorldBuilderMode() || isInAdvancedStart())
@@ -2926,6 +2935,9 @@ void CvGame::update()
 		updateScore();
 		updateWar();
 		updateMoves();
+		// <advc.opt>
+		if (isBulkAIMoves())
+			updateMovesBulk(); // </advc.opt>
 		updateTimers();
 		updateTurnTimer();
 		AI().AI_updateAssignWork();
@@ -2956,6 +2968,9 @@ void CvGame::update()
 			m_pRiseFall->restoreDiploText(); // </advc.705>
 	}
 	PROFILE_END();
+	// <advc.003o>
+	if (AutoPlayBenchmark::getInstance() != NULL)
+		AutoPlayBenchmark::getInstance()->endUpdate(); // </advc.003o>
 	stopProfilingDLL(false);
 }
 
@@ -3493,6 +3508,7 @@ CvDeal* CvGame::implementAndReturnDeal(PlayerTypes eWho, PlayerTypes eOtherWho,
 	CvDeal* pDeal = addDeal();
 	pDeal->init(pDeal->getID(), eWho, eOtherWho);
 	pDeal->addTradeItems(kOurList, kTheirList, !bForce);
+	CvPlayerAI::AI_invalidateTradeValCache(); // advc.opt
 	if (pDeal->getLengthFirst() <= 0 && pDeal->getLengthSecond() <= 0)
 	{
 		pDeal->kill();
@@ -4239,6 +4255,7 @@ int CvGame::getGameTurnYear() const // advc: const
 void CvGame::incrementElapsedGameTurns()
 {
 	m_iElapsedGameTurns++;
+	CvCity::invalidateTradeProfits(); // advc.opt (see getPeaceTradeModifier)
 }
 
 // advc.251:
@@ -4739,6 +4756,8 @@ void CvGame::initScoreCalculation()
 void CvGame::setAIAutoPlay(int iNewValue, /* <advc.127> */ bool bChangePlayerStatus)
 {
 	m_iAIAutoPlay = std::max(0, iNewValue);
+	if (m_iAIAutoPlay == 0)
+		AutoPlayBenchmark::end(); // advc.003o
 	if(!bChangePlayerStatus)
 		return; // </advc.127>
 	// Erik <BM1>
@@ -4953,6 +4972,8 @@ bool CvGame::isScoreDirty() const
 void CvGame::setScoreDirty(bool bNewValue)
 {
 	m_bScoreDirty = bNewValue;
+	if (bNewValue) // advc.opt
+		CvGameTextMgr::invalidateHelpTextCache();
 }
 
 // <advc.003r>
@@ -6599,6 +6620,9 @@ void CvGame::addGreatPersonBornName(const CvWString& szName)
 void CvGame::doTurn()
 {
 	PROFILE_BEGIN("CvGame::doTurn()");
+	// <advc.003o>
+	if (AutoPlayBenchmark::getInstance() != NULL)
+		AutoPlayBenchmark::getInstance()->beginGameTurn(); // </advc.003o>
 
 	// END OF TURN
 	if(!CvPlot::isAllFog()) // advc.706: Suppress popups
@@ -8362,6 +8386,43 @@ void CvGame::updateMoves()
 }
 
 
+/*	advc.opt: Keep processing AI moves until the AI players whose turn is active
+	are done or a human player's turn begins - instead of returning to the EXE
+	after every step. Skips the animations of units that move in between. */
+void CvGame::updateMovesBulk()
+{
+	PROFILE_FUNC();
+	// Safety measure against infinite loops; the next update will continue.
+	int const iMaxPasses = 500;
+	for (int iPass = 0; iPass < iMaxPasses; iPass++)
+	{
+		bool bAnyAITurnActive = false;
+		for (int iI = 0; iI < MAX_PLAYERS; iI++)
+		{
+			CvPlayer const& kPlayer = GET_PLAYER((PlayerTypes)iI);
+			if (!kPlayer.isAlive() || !kPlayer.isTurnActive())
+				continue;
+			if (kPlayer.isHuman())
+				return;
+			bAnyAITurnActive = true;
+		}
+		/*	Once all players are through, the next update starts the new game turn
+			(and the EXE gets to render the map at least once per game turn). */
+		if (!bAnyAITurnActive)
+			return;
+		updateMoves();
+		updateTimers();
+		testAlive();
+	}
+}
+
+// advc.opt: Enabled through GlobalDefines_devel.xml; not for network games.
+bool CvGame::isBulkAIMoves() const
+{
+	return (GC.getDefineBOOL("BULK_AI_MOVES") && !isNetworkMultiPlayer());
+}
+
+
 void CvGame::verifyCivics()
 {
 	for (int iI = 0; iI < MAX_PLAYERS; iI++)
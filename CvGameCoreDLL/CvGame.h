@@ -198,6 +198,7 @@ public:
 		return GC.getInitCore().getMultiplayer(); // advc.inl
 	}
 	DllExport bool isGameMultiPlayer() const;																			// Exposed to Python
+	bool isBulkAIMoves() const; // advc.opt
 	DllExport bool isTeamGame() const;																						// Exposed to Python
 
 	bool isModem() const; // advc: const
@@ -1055,6 +1056,7 @@ protected:
 
 	void updateWar();
 	void updateMoves();
+	void updateMovesBulk(); // advc.opt
 	void updateTimers();
 	void updateTurnTimer();
 
@@ -22,6 +22,8 @@
 
 static char* szErrorMsg; // for displaying assertion and error messages
 
+int CvGameTextMgr::m_iHelpTextEpoch = 0; // advc.opt
+
 
 CvGameTextMgr& CvGameTextMgr::GetInstance()
 {
@@ -16379,7 +16381,24 @@ void CvGameTextMgr::parsePlayerTraits(CvWStringBuffer &szBuffer, PlayerTypes ePl
 }
 
 // K-Mod. I've rewritten most of this function.
+// advc.opt: Memoized; see comment above HelpTextKey.
 void CvGameTextMgr::parseLeaderHeadHelp(CvWStringBuffer &szBuffer, PlayerTypes eThisPlayer, PlayerTypes eOtherPlayer)
+{
+	HelpTextKey key(makeHelpTextKey());
+	key.aiData[HELP_KEY_FIRST_CALLER_SLOT] = eThisPlayer;
+	key.aiData[HELP_KEY_FIRST_CALLER_SLOT + 1] = eOtherPlayer;
+	if (!(key == m_leaderHeadHelpKey))
+	{
+		m_szLeaderHeadHelp.clear();
+		parseLeaderHeadHelpUncached(m_szLeaderHeadHelp, eThisPlayer, eOtherPlayer);
+		m_leaderHeadHelpKey = key;
+	}
+	szBuffer.append(m_szLeaderHeadHelp.getCString());
+}
+
+
+void CvGameTextMgr::parseLeaderHeadHelpUncached(CvWStringBuffer &szBuffer,
+	PlayerTypes eThisPlayer, PlayerTypes eOtherPlayer)
 {
 	if (eThisPlayer == NO_PLAYER)
 		return;
@@ -19545,8 +19564,75 @@ void CvGameTextMgr::getGlobeLayerName(GlobeLayerTypes eType, int iOption, CvWStr
 	}
 }
 
+// advc.opt: Memoized; see comment above HelpTextKey.
 void CvGameTextMgr::getPlotHelp(CvPlot* pMouseOverPlot, CvCity* pCity, CvPlot* pFlagPlot,
 	bool bAlt, CvWStringBuffer& strHelp)
+{
+	CvMap const& kMap = GC.getMap();
+	HelpTextKey key(makeHelpTextKey());
+	int* aiCallerData = &key.aiData[HELP_KEY_FIRST_CALLER_SLOT];
+	if (pMouseOverPlot != NULL)
+		aiCallerData[0] = kMap.plotNum(*pMouseOverPlot);
+	if (pCity != NULL)
+	{
+		aiCallerData[1] = pCity->getOwner();
+		aiCallerData[2] = pCity->getID();
+	}
+	if (pFlagPlot != NULL)
+		aiCallerData[3] = kMap.plotNum(*pFlagPlot);
+	aiCallerData[4] = bAlt;
+	if (!(key == m_plotHelpKey))
+	{
+		m_szPlotHelp.clear();
+		getPlotHelpUncached(pMouseOverPlot, pCity, pFlagPlot, bAlt, m_szPlotHelp);
+		m_plotHelpKey = key;
+	}
+	strHelp.append(m_szPlotHelp.getCString());
+}
+
+/*	advc.opt: Covers everything outside of the plot, city and widget data
+	that the plot help and leaderhead help read. Game state changes are
+	covered by the danger/ combat cache epoch (units, plot ownership,
+	terrain, visibility, war, techs, damage), the explicit invalidations
+	(city and unit info, plot flags, scores) and the turn slice. The latter
+	bounds how long changes that don't bump any of the counters (e.g. gold,
+	attitude) can remain invisible: CvGame::update increments it only a few
+	times per second, so the text still gets reused across many frames. */
+CvGameTextMgr::HelpTextKey CvGameTextMgr::makeHelpTextKey()
+{
+	CvGame const& kGame = GC.getGame();
+	CvDLLInterfaceIFaceBase& kUI = gDLL->UI();
+	HelpTextKey key;
+	key.aiData[HELP_KEY_EPOCH] = m_iHelpTextEpoch;
+	key.aiData[HELP_KEY_COMBAT_EPOCH] = CvPlayerAI::AI_getCombatCacheEpoch();
+	key.aiData[HELP_KEY_TURN_SLICE] = kGame.getTurnSlice();
+	key.aiData[HELP_KEY_ACTIVE_PLAYER] = kGame.getActivePlayer();
+	key.aiData[HELP_KEY_FLAGS] = (GC.ctrlKey() ? 1 : 0) | (GC.shiftKey() ? 2 : 0) |
+			(GC.altKey() ? 4 : 0) | (kGame.isDebugMode() ? 8 : 0) |
+			(kUI.isCityScreenUp() ? 16 : 0);
+	key.aiData[HELP_KEY_INTERFACE_MODE] = kUI.getInterfaceMode();
+	CvUnit const* pSelectedUnit = kUI.getHeadSelectedUnit();
+	if (pSelectedUnit != NULL)
+	{
+		key.aiData[HELP_KEY_SELECTED_UNIT_OWNER] = pSelectedUnit->getOwner();
+		key.aiData[HELP_KEY_SELECTED_UNIT_ID] = pSelectedUnit->getID();
+	}
+	key.aiData[HELP_KEY_SELECTION_LENGTH] = kUI.getLengthSelectionList();
+	CvCity const* pSelectedCity = kUI.getHeadSelectedCity();
+	if (pSelectedCity != NULL)
+	{
+		key.aiData[HELP_KEY_SELECTED_CITY_OWNER] = pSelectedCity->getOwner();
+		key.aiData[HELP_KEY_SELECTED_CITY_ID] = pSelectedCity->getID();
+	}
+	CvPlot const* pGotoPlot = kUI.getGotoPlot();
+	if (pGotoPlot != NULL)
+		key.aiData[HELP_KEY_GOTO_PLOT] = GC.getMap().plotNum(*pGotoPlot);
+	return key;
+}
+
+
+void CvGameTextMgr::getPlotHelpUncached(CvPlot* pMouseOverPlot, CvCity* pCity,
+	CvPlot* pFlagPlot, bool bAlt, CvWStringBuffer& strHelp)
 {
 	TeamTypes const eActiveTeam = GC.getGame().getActiveTeam();
 	CvDLLInterfaceIFaceBase& kUI = gDLL->UI();
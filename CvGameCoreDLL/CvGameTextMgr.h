@@ -23,6 +23,13 @@ public:
 	DllExport void Initialize();
 	DllExport void DeInitialize();
 	DllExport void Reset();
+	/*	advc.opt: To be called upon changes that the cached plot and leaderhead
+		help text can depend on and that no cache key covers
+		(see makeHelpTextKey). */
+	static inline void invalidateHelpTextCache()
+	{
+		m_iHelpTextEpoch++;
+	}
 
 	int getCurrentLanguage();
 
@@ -356,6 +363,46 @@ private:
 	  static bool listFirstUnitTypeBeforeSecond(UnitTypes eFirst, UnitTypes eSecond);
 	// </advc.061>
 	std::vector<int*> m_apbPromotion;
+	/*	<advc.opt> The EXE requests the help text for the plot or widget under
+		the mouse cursor on every frame. The plot help (getPlotHelp) and the
+		leaderhead help (scoreboard) are remembered along with the inputs that
+		they depend on, so that they only get recomputed when those change. */
+	struct HelpTextKey
+	{
+		HelpTextKey() { std::fill(aiData, aiData + ARRAY_LENGTH(aiData), -1); }
+		bool operator==(HelpTextKey const& kOther) const
+		{
+			return std::equal(aiData, aiData + ARRAY_LENGTH(aiData), kOther.aiData);
+		}
+		int aiData[18];
+	};
+	enum HelpTextSlots
+	{
+		HELP_KEY_EPOCH,
+		HELP_KEY_COMBAT_EPOCH,
+		HELP_KEY_TURN_SLICE,
+		HELP_KEY_ACTIVE_PLAYER,
+		HELP_KEY_FLAGS, // modifier keys, debug mode, city screen
+		HELP_KEY_INTERFACE_MODE,
+		HELP_KEY_SELECTED_UNIT_OWNER,
+		HELP_KEY_SELECTED_UNIT_ID,
+		HELP_KEY_SELECTION_LENGTH,
+		HELP_KEY_SELECTED_CITY_OWNER,
+		HELP_KEY_SELECTED_CITY_ID,
+		HELP_KEY_GOTO_PLOT,
+		HELP_KEY_FIRST_CALLER_SLOT // Rest is up to the caller
+	};
+	static int m_iHelpTextEpoch;
+	HelpTextKey m_plotHelpKey;
+	CvWStringBuffer m_szPlotHelp;
+	HelpTextKey m_leaderHeadHelpKey;
+	CvWStringBuffer m_szLeaderHeadHelp;
+	static HelpTextKey makeHelpTextKey();
+	void getPlotHelpUncached(CvPlot* pMouseOverPlot, CvCity* pCity, CvPlot* pFlagPlot,
+			bool bAlt, CvWStringBuffer& strHelp);
+	void parseLeaderHeadHelpUncached(CvWStringBuffer &szBuffer,
+			PlayerTypes eThisPlayer, PlayerTypes eOtherPlayer);
+	// </advc.opt>
 };
 
 // Singleton Accessor
@@ -10,6 +10,7 @@
 #include "CvXMLLoadUtility.h" // advc.003v
 #include "CvDLLUtilityIFaceBase.h"
 #include "CvDLLXMLIFaceBase.h"
+#include "XMLPrefetcher.h" // advc.opt
 // <advc.003o>
 #ifdef USE_TSC_PROFILER
 #include "TSCProfiler.h"
@@ -263,6 +264,9 @@ void CvGlobals::uninit() // free
 	#ifdef USE_TSC_PROFILER
 	TSCProfiler::getInstance().writeFile();
 	#endif // </advc.003o>
+	/*	advc.opt: Normally finished long before. Not stopped after LoadPostMenuGlobals
+		because it also covers the files loaded on demand (advc.003v). */
+	XMLPrefetcher::stop();
 	SAFE_DELETE_ARRAY(m_aiGlobalDefinesCache); // advc
 
 	SAFE_DELETE(m_game);
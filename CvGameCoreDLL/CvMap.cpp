@@ -31,6 +31,10 @@ CvMap::CvMap()
 {
 	CvMapInitData defaultMapData;
 	m_pMapPlots = NULL;
+	// <advc.opt>
+	CvPlot::setVisibilityStore(&m_visibility);
+	m_iFoundValueStamp = 1;
+	m_iAllFoundValuesDirtyStamp = 1; // </advc.opt>
 	reset(&defaultMapData);
 }
 
@@ -57,6 +61,7 @@ void CvMap::init(CvMapInitData* pInitInfo)
 	setup();
 	gDLL->logMemState("CvMap before init plots");
 	FAssert(numPlots() <= (EnumMap<PlotNumTypes,scaled>::MAX_LENGTH)); // advc.enum
+	m_visibility.init(getGridWidth(), numPlots()); // advc.opt
 	m_pMapPlots = new CvPlot[numPlots()];
 	for (int iX = 0; iX < getGridWidth(); iX++)
 	{
@@ -70,6 +75,7 @@ void CvMap::init(CvMapInitData* pInitInfo)
 	FOR_EACH_ENUM(PlotNum)
 		getPlotByIndex(eLoopPlotNum).initAdjList(); // </advc.opt>
 	calculateAreas();
+	m_plotFields.init(*this); // advc.opt
 	gDLL->logMemState("CvMap after init plots");
 }
 
@@ -77,9 +83,16 @@ void CvMap::init(CvMapInitData* pInitInfo)
 void CvMap::uninit()
 {
 	SAFE_DELETE_ARRAY(m_pMapPlots);
+	// <advc.opt>
+	m_plotFields.uninit();
+	m_visibility.uninit();
+	CvPlot::resetBestDefenderCache(); // </advc.opt>
 	m_replayTexture.clear(); // advc.106n
 	m_areas.uninit();
 	CvSelectionGroup::uninitPathFinder(); // advc.pf
+	// <advc.opt>
+	m_aiFoundValueStamp.clear();
+	setAllFoundValuesDirty(); // </advc.opt>
 }
 
 // Initializes data members that are serialized.
@@ -255,10 +268,19 @@ void CvMap::erasePlots()
 void CvMap::setRevealedPlots(TeamTypes eTeam, bool bNewValue, bool bTerrainOnly)
 {
 	PROFILE_FUNC();
-
-	for (int iI = 0; iI < numPlots(); iI++)
+	/*	<advc.opt> Unless the revealed owner, improvement and route get refreshed,
+		plots whose revealed flag already equals bNewValue are unaffected.
+		Skip whole blocks of such plots. */
+	int const iBlockSize = PlotVisibility::BLOCK_SIZE;
+	for (int iBlock = 0; iBlock < m_visibility.numBlocks(); iBlock++)
 	{
-		getPlotByIndex(iI).setRevealed(eTeam, bNewValue, bTerrainOnly, NO_TEAM, false);
+		if (bTerrainOnly && m_visibility.isRevealedBlock(eTeam, iBlock, bNewValue))
+			continue;
+		int const iEnd = std::min(numPlots(), (iBlock + 1) * iBlockSize);
+		for (int iI = iBlock * iBlockSize; iI < iEnd; iI++) // </advc.opt>
+		{
+			getPlotByIndex(iI).setRevealed(eTeam, bNewValue, bTerrainOnly, NO_TEAM, false);
+		}
 	}
 
 	GC.getGame().updatePlotGroups();
@@ -507,13 +529,13 @@ void CvMap::combinePlotGroups(PlayerTypes ePlayer, CvPlotGroup* pPlotGroup1, CvP
 		pOldPlotGroup = pPlotGroup1;
 	}
 
-	CLLNode<XYCoords>* pPlotNode = pOldPlotGroup->headPlotsNode();
-	while (pPlotNode != NULL)
-	{
+	/*CLLNode<XYCoords>* pPlotNode = pOldPlotGroup->headPlotsNode();
+	while (pPlotNode != NULL) {
 		CvPlot& kPlot = getPlot(pPlotNode->m_data.iX, pPlotNode->m_data.iY);
-		pNewPlotGroup->addPlot(&kPlot, /* advc.064d: */ bVerifyProduction);
+		pNewPlotGroup->addPlot(&kPlot, bVerifyProduction);
 		pPlotNode = pOldPlotGroup->deletePlotsNode(pPlotNode);
-	}
+	}*/ // advc.opt: Bonus counts get merged all at once
+	pNewPlotGroup->absorb(*pOldPlotGroup, /* advc.064d: */ bVerifyProduction);
 }
 
 
@@ -1045,6 +1067,7 @@ void CvMap::recalculateAreas(/* advc.opt: */bool bUpdateIsthmuses)
 		getPlotByIndex(i).setArea(NULL);
 	m_areas.removeAll();
 	calculateAreas();
+	setAllFoundValuesDirty(); // advc.opt
 }
 
 
@@ -1124,6 +1147,76 @@ void CvMap::updateIrrigated(CvPlot& kPlot)
 }
 
 
+// advc.opt:
+void CvMap::setFoundValuesDirty(CvPlot const& kPlot, bool bCity)
+{
+	/*	The evaluation of a city site looks at plots up to a distance of 6
+		(bad tiles in the greater range, resources contested by other sites) and
+		at the plots of the cities whose radius overlaps with the site's radius. */
+	int iRange = foundValueRange();
+	if (bCity)
+	{	// Foreign proximity counts cities within their culture range plus 3
+		iRange = std::max(iRange + GC.getDefineINT(CvGlobals::MIN_CITY_RANGE),
+				GC.getNumCultureLevelInfos() - 1 + 3);
+	}
+	markFoundValuesDirty(kPlot, iRange);
+}
+
+// advc.opt:
+void CvMap::setCityRadiusFoundValuesDirty(CvPlot const& kPlot)
+{
+	markFoundValuesDirty(kPlot, CITY_PLOTS_RADIUS);
+}
+
+// advc.opt:
+void CvMap::markFoundValuesDirty(CvPlot const& kPlot, int iRange)
+{
+	if ((int)m_aiFoundValueStamp.size() != numPlots())
+		m_aiFoundValueStamp.resize(numPlots(), 0);
+	for (SquareIter it(kPlot, iRange); it.hasNext(); ++it)
+		m_aiFoundValueStamp[plotNum(*it)] = m_iFoundValueStamp;
+}
+
+// advc.opt:
+void CvMap::setAllFoundValuesDirty()
+{
+	m_iAllFoundValuesDirtyStamp = m_iFoundValueStamp;
+}
+
+
+// advc.opt:
+void CvMap::PlotFields::init(CvMap const& kMap)
+{
+	int const iPlots = kMap.numPlots();
+	m_aeOwner.resize(iPlots);
+	m_aeTeam.resize(iPlots);
+	m_aeBonus.resize(iPlots);
+	m_aiArea.resize(iPlots);
+	FOR_EACH_ENUM(PlotNum)
+		update(kMap.getPlotByIndex(eLoopPlotNum), eLoopPlotNum);
+}
+
+// advc.opt:
+void CvMap::PlotFields::uninit()
+{
+	m_aeOwner.clear();
+	m_aeTeam.clear();
+	m_aeBonus.clear();
+	m_aiArea.clear();
+}
+
+// advc.opt:
+void CvMap::PlotFields::update(CvPlot const& kPlot, PlotNumTypes ePlot)
+{
+	FAssertBounds(0, (int)m_aeOwner.size(), ePlot);
+	m_aeOwner[ePlot] = toChar(kPlot.getOwner());
+	m_aeTeam[ePlot] = toChar(kPlot.getTeam());
+	m_aeBonus[ePlot] = toShort(kPlot.getBonusType());
+	m_aiArea[ePlot] = (kPlot.area() == NULL ? FFreeList::INVALID_INDEX :
+			kPlot.getArea().getID());
+}
+
+
 // BETTER_BTS_AI_MOD, Efficiency (plot danger cache), 08/21/09, jdog5000: START
 void CvMap::invalidateActivePlayerSafeRangeCache()
 {
@@ -1177,6 +1270,7 @@ void CvMap::read(FDataStreamBase* pStream)
 
 	if (numPlots() > 0)
 	{
+		m_visibility.init(getGridWidth(), numPlots()); // advc.opt
 		m_pMapPlots = new CvPlot[numPlots()];
 		for (int i = 0; i < numPlots(); i++)
 			m_pMapPlots[i].read(pStream);
@@ -1196,6 +1290,7 @@ void CvMap::read(FDataStreamBase* pStream)
 	{
 		plotByIndex(i)->initArea();
 	} // </advc>
+	m_plotFields.init(*this); // advc.opt
 	setup();
 	computeShelves(); // advc.300
 	/*  advc.004z: Not sure if this is the ideal place for this, but it works.
@@ -495,6 +495,23 @@ public: // advc: made several functions const
 	void resetPathDistance();																		// Exposed to Python
 	int calculatePathDistance(CvPlot const* pSource, CvPlot const* pDest) const;					// Exposed to Python
 	void updateIrrigated(CvPlot& kPlot); // advc.pf
+	/*	<advc.opt> For CvPlayerAI::AI_updateFoundValues. Marks the found values
+		of the sites within a range of kPlot as changed. bCity for changes to a
+		city on kPlot, which can affect the sites in the city's culture range. */
+	void setFoundValuesDirty(CvPlot const& kPlot, bool bCity = false);
+	// Only the sites whose city radius contains kPlot
+	void setCityRadiusFoundValuesDirty(CvPlot const& kPlot);
+	// Range of setFoundValuesDirty for changes other than to cities
+	static int foundValueRange() { return 3 * CITY_PLOTS_RADIUS + 1; }
+	void setAllFoundValuesDirty();
+	// Returns the current stamp and starts a new one
+	int advanceFoundValueStamp() { return m_iFoundValueStamp++; }
+	bool isFoundValueDirty(CvPlot const& kPlot, int iSinceStamp) const
+	{
+		return (m_iAllFoundValuesDirtyStamp > iSinceStamp ||
+				(!m_aiFoundValueStamp.empty() && // (empty until the first mark)
+				m_aiFoundValueStamp[plotNum(kPlot)] > iSinceStamp));
+	} // </advc.opt>
 
 	// BETTER_BTS_AI_MOD, Efficiency (plot danger cache), 08/21/09, jdog5000: START
 	//void invalidateIsActivePlayerNoDangerCache();
@@ -540,6 +557,51 @@ public: // advc: made several functions const
 	MinimapSettings& getMinimapSettings() { return m_minimapSettings; }
 	MinimapSettings const& getMinimapSettings() const { return m_minimapSettings; }
 	// </advc.002a>
+	/*	<advc.opt> Packed copies of the CvPlot fields that map-wide scans filter
+		by (owner, team, bonus, area), indexed by plot number. Lets such scans
+		skip plots without loading the (large) CvPlot objects. Kept in sync by
+		the CvPlot setters; not serialized - rebuilt from the plots after init
+		and read. Add a field only together with a scan that reads it. */
+	class PlotFields : private boost::noncopyable
+	{
+	public:
+		void init(CvMap const& kMap);
+		void uninit();
+		bool isInitialized() const { return !m_aeOwner.empty(); }
+		void update(CvPlot const& kPlot, PlotNumTypes ePlot);
+		PlayerTypes getOwner(int iPlot) const
+		{
+			return (PlayerTypes)m_aeOwner[iPlot];
+		}
+		TeamTypes getTeam(int iPlot) const
+		{
+			return (TeamTypes)m_aeTeam[iPlot];
+		}
+		// Not revealed-aware; same as CvPlot::getBonusType(NO_TEAM).
+		BonusTypes getBonusType(int iPlot) const
+		{
+			return (BonusTypes)m_aeBonus[iPlot];
+		}
+		int getAreaID(int iPlot) const { return m_aiArea[iPlot]; }
+	private:
+		std::vector<char> m_aeOwner;
+		std::vector<char> m_aeTeam;
+		std::vector<short> m_aeBonus;
+		std::vector<int> m_aiArea;
+	};
+	PlotFields const& getPlotFields() const
+	{
+		FAssert(m_plotFields.isInitialized());
+		return m_plotFields;
+	}
+	// For the CvPlot setters
+	void updatePlotFields(CvPlot const& kPlot)
+	{
+		if (m_plotFields.isInitialized())
+			m_plotFields.update(kPlot, plotNum(kPlot));
+	} // </advc.opt>
+	// advc.opt: Visibility counts and revealed flags of all plots
+	PlotVisibility const& getVisibility() const { return m_visibility; }
 
 protected:
 
@@ -561,8 +623,14 @@ protected:
 	CvPlot* m_pMapPlots;
 	std::map<Shelf::Id,Shelf*> m_shelves; // advc.300
 	FFreeListTrashArray<CvArea> m_areas;
+	// <advc.opt> Not serialized
+	std::vector<int> m_aiFoundValueStamp;
+	int m_iFoundValueStamp;
+	int m_iAllFoundValuesDirtyStamp; // </advc.opt>
 	std::vector<byte> m_replayTexture; // advc.106n
 	MinimapSettings m_minimapSettings; // advc.002a
+	PlotFields m_plotFields; // advc.opt
+	PlotVisibility m_visibility; // advc.opt (not serialized here)
 
 	void calculateAreas();
 	// <advc.030>
@@ -572,6 +640,7 @@ protected:
 	void updateLakes();
 	// </advc.030>
 	void updatePlotNum(); // advc.opt
+	void markFoundValuesDirty(CvPlot const& kPlot, int iRange); // advc.opt
 };
 
 // advc.enum: (for EnumMap)
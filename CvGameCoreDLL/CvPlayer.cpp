@@ -20,6 +20,7 @@
 #include "CvBugOptions.h"
 #include "CvDLLFlagEntityIFaceBase.h" // BBAI
 #include "BBAILog.h"
+#include "AutoPlayBenchmark.h" // advc.003o
 
 // advc.003u: Statics moved from CvPlayerAI
 CvPlayerAI** CvPlayer::m_aPlayers = NULL;
@@ -2366,6 +2367,7 @@ CvSelectionGroup* CvPlayer::cycleSelectionGroups(CvUnit* pUnit, bool bForward,
 // AI_AUTO_PLAY_MOD, 07/09/08, jdog5000:
 void CvPlayer::setHumanDisabled(bool bNewVal)
 {
+	CvPlayerAI::AI_invalidateDangerCache(); // advc.opt
 	// <advc.127>
 	m_bAutoPlayJustEnded = true;
 	CvGame& kGame = GC.getGame();
@@ -3040,6 +3042,10 @@ void CvPlayer::updateTradeRoutes()
 
 	FOR_EACH_CITY_VAR(pLoopCity, *this)
 		pLoopCity->clearTradeRoutes();
+	// advc.opt: Only one pass through the cities of all trade partners
+	TradeRouteCandidates candidates;
+	getTradeRouteCandidates(candidates);
+	std::vector<CvCity*> const apNoCandidates;
 
 	CLinkList<int> cityList;
 	FOR_EACH_CITY_VAR(pLoopCity, *this)
@@ -3065,11 +3071,41 @@ void CvPlayer::updateTradeRoutes()
 	CLLNode<int>* pCityNode = cityList.head();
 	while (pCityNode != NULL)
 	{
-		getCity(pCityNode->m_data)->updateTradeRoutes();
+		CvCity& kCity = *getCity(pCityNode->m_data);
+		// <advc.opt>
+		TradeRouteCandidates::const_iterator itCandidates = candidates.find(
+				CvCity::isIgnorePlotGroupsForTradeRoutes() ? NULL : kCity.plotGroup(getID()));
+		kCity.updateTradeRoutes(itCandidates == candidates.end() ? apNoCandidates :
+				itCandidates->second); // </advc.opt>
 		pCityNode = cityList.next(pCityNode);
 	}
 }
 
+/*	advc.opt: Cut from CvCity::updateTradeRoutes. Applies the checks that don't
+	depend on the city of this player that establishes the trade route or on the
+	routes already established. The order (by player, then by city) is the
+	one in which CvCity::updateTradeRoutes used to evaluate the cities; it
+	matters for breaking ties. */
+void CvPlayer::getTradeRouteCandidates(TradeRouteCandidates& kCandidates) const
+{
+	bool const bIgnorePlotGroups = CvCity::isIgnorePlotGroupsForTradeRoutes();
+	for (PlayerIter<MAJOR_CIV> it; it.hasNext(); ++it)
+	{
+		CvPlayer const& kPartner = *it;
+		if(!canHaveTradeRoutesWith(kPartner.getID()))
+			continue;
+		FOR_EACH_CITY_VAR(pLoopCity, kPartner)
+		{
+			/*  <advc.124> A connection along revealed tiles ensures that the
+				city tile is revealed, but not that the city is revealed. */
+			if(pLoopCity->isDisorder() || !pLoopCity->isRevealed(getTeam()))
+				continue; // <advc.124>
+			kCandidates[bIgnorePlotGroups ? NULL : pLoopCity->plotGroup(getID())].
+					push_back(pLoopCity);
+		}
+	}
+}
+
 void CvPlayer::updatePlunder(int iChange, bool bUpdatePlotGroups)
 {
 	FOR_EACH_UNIT_VAR(pLoopUnit, *this)
@@ -8183,6 +8219,12 @@ void CvPlayer::setCapital(CvCity* pNewCapital)
 	if (pNewCapital != NULL)
 		m_iCapitalCityID = pNewCapital->getID();
 	else m_iCapitalCityID = FFreeList::INVALID_INDEX;
+	// <advc.opt>
+	CvCity::invalidateTradeProfits();
+	if (pOldCapital != NULL)
+		GC.getMap().setFoundValuesDirty(pOldCapital->getPlot());
+	if (pNewCapital != NULL)
+		GC.getMap().setFoundValuesDirty(pNewCapital->getPlot()); // </advc.opt>
 
 	if (bUpdatePlotGroups)
 	{
@@ -8719,10 +8761,14 @@ void CvPlayer::setTurnActive(bool bNewValue, bool bDoTurn)
 		return;
 
 	m_bTurnActive = bNewValue;
+	CvPlayerAI::AI_invalidateDangerCache(); // advc.opt
 	CvGame& kGame = GC.getGame();
 	if (isTurnActive())
 	{
 		FAssert(isAlive());
+		// <advc.003o>
+		if (AutoPlayBenchmark::getInstance() != NULL)
+			AutoPlayBenchmark::getInstance()->beginPlayerTurn(getID()); // </advc.003o>
 		// <advc.001x> (or move this to the very end of doTurn?)
 		changeGoldenAgeTurns(getGoldenAgeLength() * m_iScheduledGoldenAges);
 		m_iScheduledGoldenAges = 0;
@@ -9145,6 +9191,7 @@ void CvPlayer::setCurrentEra(EraTypes eNewValue)
 
 	EraTypes eOldEra = m_eCurrentEra;
 	m_eCurrentEra = eNewValue;
+	CvPlayerAI::AI_invalidateDangerCache(); // advc.opt
 
 	if (GC.getGame().getActiveTeam() != NO_TEAM)
 	{
@@ -10726,6 +10773,7 @@ CvSelectionGroup* CvPlayer::addSelectionGroup()
 		(we can update the specific position in the cycle list later;
 		but it's important to get it into the list.) */
 	m_groupCycle.insertAtEnd(pGroup->getID());
+	AI().AI_setMovementPriorityDirty(pGroup->getID()); // advc.opt
 	return pGroup;
 }
 
@@ -10737,6 +10785,7 @@ void CvPlayer::deleteSelectionGroup(int iID)
 	#endif
 	m_selectionGroups.removeAt(iID);
 	FAssertMsg(bRemoved, "could not find group, delete failed");
+	AI().AI_setMovementPriorityDirty(iID); // advc.opt
 }
 
 EventTriggeredData* CvPlayer::firstEventTriggered(int *pIterIdx, bool bRev) const
@@ -179,6 +179,10 @@ public:
 	//void updateCityPlotYield(); // advc.003j
 	void updateCitySight(bool bIncrement, bool bUpdatePlotGroups);
 	void updateTradeRoutes();
+	// <advc.opt> Cities of trade partners grouped by plot group (of this player)
+	typedef std::map<CvPlotGroup const*,std::vector<CvCity*> > TradeRouteCandidates;
+	void getTradeRouteCandidates(TradeRouteCandidates& kCandidates) const;
+	// </advc.opt>
 	void updatePlunder(int iChange, bool bUpdatePlotGroups);
 
 	void updateTimers();
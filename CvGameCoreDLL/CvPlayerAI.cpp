@@ -26,6 +26,14 @@
 #define iSINGLE_BONUS_TRADE_TOLERANCE	(20) // advc.036
 
 // statics ... (advc.003u: Mostly moved to CvPlayer)
+int CvPlayerAI::m_iDangerCacheEpoch = 0; // advc.opt
+// <advc.opt>
+int CvPlayerAI::m_iDangerStamp = 0;
+std::vector<int> CvPlayerAI::m_aiDangerPlotStamps; // </advc.opt>
+int CvPlayerAI::m_iCombatCacheEpoch = 0; // advc.opt
+// <advc.opt>
+int CvPlayerAI::m_iTradeValCacheEpoch = 0;
+bool CvPlayerAI::m_bTradeValCacheActive = false; // </advc.opt>
 
 bool CvPlayerAI::areStaticsInitialized()
 {
@@ -174,6 +182,21 @@ void CvPlayerAI::AI_reset(bool bConstructor)
 	m_iReligionTimer = 0;
 	m_iExtraGoldTarget = 0;
 	m_iCityTargetTimer = 0; // K-Mod
+	// <advc.opt>
+	m_aDangerCache.clear();
+	m_aDefenceCache.clear();
+	m_aiBonusTradeValCache.clear();
+	m_iBonusTradeValCacheEpoch = -1;
+	m_aiBaseFoundValue.clear();
+	m_aiFoundValueInputs.clear();
+	m_aiFoundValueBonusInputs.clear();
+	m_iFoundValueStamp = 0;
+	m_movementPriorityQueue.clear();
+	m_movementPriorityKeys.clear();
+	m_aiMovementPriorityDirty.clear();
+	m_iMovementPriorityTurn = -1;
+	m_iMovementPriorityBestCombat = 0;
+	m_bMovementPriorityCities = false; // </advc.opt>
 
 	// CHANGE_PLAYER, 06/08/09, jdog5000: START
 	if (bConstructor || getNumUnits() == 0)
@@ -1022,12 +1045,59 @@ void CvPlayerAI::AI_updateFoundValues(bool bStarting)  // advc: refactored
 	}
 	CitySiteEvaluator citySiteEval(*this);
 	AI_invalidateCitySites(/*AI_getMinFoundValue()*/-1); // K-Mod
+	/*	<advc.opt> Reuse the values of sites with no nearby changes (see
+		CvMap::setFoundValuesDirty) if the inputs that aren't tied to
+		particular plots are still the same as in the previous update. */
+	CvMap& kMap = GC.getMap();
+	// Sites near resources whose inputs have changed; empty if there are none.
+	std::vector<bool> abBonusDirty;
+	{
+		std::vector<int> aiInputs;
+		AI_getFoundValueInputs(citySiteEval, aiInputs);
+		std::vector<int> aiBonusInputs;
+		AI_getFoundValueBonusInputs(aiBonusInputs);
+		if (aiInputs != m_aiFoundValueInputs ||
+			aiBonusInputs.size() != m_aiFoundValueBonusInputs.size() ||
+			(int)m_aiBaseFoundValue.size() != kMap.numPlots())
+		{
+			m_aiFoundValueInputs.swap(aiInputs);
+			m_aiBaseFoundValue.clear();
+			m_aiBaseFoundValue.resize(kMap.numPlots(), -1);
+		}
+		else if (aiBonusInputs != m_aiFoundValueBonusInputs)
+		{
+			int const iInputsPerBonus = (int)aiBonusInputs.size() /
+					GC.getNumBonusInfos();
+			std::vector<bool> abChanged(GC.getNumBonusInfos(), false);
+			for (size_t i = 0; i < aiBonusInputs.size(); i++)
+			{
+				if (aiBonusInputs[i] != m_aiFoundValueBonusInputs[i])
+					abChanged[i / iInputsPerBonus] = true;
+			}
+			abBonusDirty.resize(kMap.numPlots(), false);
+			for (int i = 0; i < kMap.numPlots(); i++)
+			{
+				CvPlot const& kPlot = kMap.getPlotByIndex(i);
+				// The evaluation may or may not look at unrevealed resources
+				BonusTypes const eBonus = kPlot.getBonusType();
+				if (eBonus == NO_BONUS || !abChanged[eBonus])
+					continue;
+				for (SquareIter it(kPlot, CvMap::foundValueRange()); it.hasNext(); ++it)
+					abBonusDirty[kMap.plotNum(*it)] = true;
+			}
+		}
+		m_aiFoundValueBonusInputs.swap(aiBonusInputs);
+	}
+	int const iSinceStamp = m_iFoundValueStamp;
+	m_iFoundValueStamp = kMap.advanceFoundValueStamp();
+	int iReused = 0;
+	int iEvaluated = 0; // </advc.opt>
 	// <advc.108>
 	int iCities = getNumCities();
 	CvPlot const* pStartPlot = getStartingPlot(); // </advc.108>
-	for(int i = 0; i < GC.getMap().numPlots(); i++)
+	for(int i = 0; i < kMap.numPlots(); i++)
 	{
-		CvPlot& kLoopPlot = GC.getMap().getPlotByIndex(i);
+		CvPlot& kLoopPlot = kMap.getPlotByIndex(i);
 		if(!kLoopPlot.isRevealed(getTeam()))
 			//&& !AI_isPrimaryArea(kLoopPlot.getArea()))
 		/*  K-Mod: Clear out any junk found values.
@@ -1040,8 +1110,16 @@ void CvPlayerAI::AI_updateFoundValues(bool bStarting)  // advc: refactored
 		}
 		short iValue = GC.getPythonCaller()->AI_foundValue(getID(), kLoopPlot);
 		if(iValue == -1)
-		{	// K-Mod:
-			iValue = citySiteEval.evaluate(kLoopPlot);
+		{	// <advc.opt>
+			iValue = m_aiBaseFoundValue[i];
+			if (iValue < 0 || kMap.isFoundValueDirty(kLoopPlot, iSinceStamp) ||
+				(!abBonusDirty.empty() && abBonusDirty[i]))
+			{	// K-Mod:
+				iValue = citySiteEval.evaluate(kLoopPlot);
+				m_aiBaseFoundValue[i] = iValue;
+				iEvaluated++;
+			}
+			else iReused++; // </advc.opt>
 			// <advc.108> Slight preference for the assigned starting plot
 			if(iCities <= 0 && pStartPlot != NULL && &kLoopPlot == pStartPlot &&
 				// Unless it doesn't have fresh water
@@ -1054,6 +1132,12 @@ void CvPlayerAI::AI_updateFoundValues(bool bStarting)  // advc: refactored
 		if(iValue > kLoopPlot.getArea().getBestFoundValue(getID()))
 			kLoopPlot.getArea().setBestFoundValue(getID(), iValue);
 	}
+	// advc.opt: Hit rate of the found value cache
+	if (gPlayerLogLevel >= 3)
+	{
+		logBBAI("    Player %d (%S) found values: %d reused, %d evaluated",
+				getID(), getCivilizationDescription(0), iReused, iEvaluated);
+	}
 	int iMaxCityCount = 4;
 	// K-Mod - because humans don't always walk towards the AI's top picks..
 	if(isHuman())
@@ -1061,6 +1145,158 @@ void CvPlayerAI::AI_updateFoundValues(bool bStarting)  // advc: refactored
 	AI_updateCitySites(-1, iMaxCityCount); // advc: -1 now means the default number
 }
 
+/*	advc.opt: Inputs of the city site evaluation that don't belong to particular
+	plots, i.e. that CvMap::setFoundValuesDirty doesn't cover. Counts that
+	AIFoundValue only compares with a threshold get clamped so that they don't
+	cause needless updates. */
+void CvPlayerAI::AI_getFoundValueInputs(CitySiteEvaluator const& kEval,
+	std::vector<int>& r) const
+{
+	PROFILE_FUNC();
+	CvMap const& kMap = GC.getMap();
+	CvTeamAI const& kOurTeam = GET_TEAM(getTeam());
+	// Settings derived from traits, techs, civics etc.
+	r.push_back(kEval.getClaimThreshold());
+	r.push_back(kEval.isEasyCulture());
+	r.push_back(kEval.isAmbitious());
+	r.push_back(kEval.isExtraCommerceThreshold());
+	r.push_back(kEval.isDefensive());
+	r.push_back(kEval.isSeafaring());
+	r.push_back(kEval.isExpansive());
+	r.push_back(kEval.isAdvancedStart());
+	r.push_back(kEval.isAllSeeing());
+	r.push_back(kEval.isScenario());
+	// Player and team
+	r.push_back(getNumCities());
+	r.push_back(isFoundedFirstCity());
+	r.push_back(isHuman());
+	r.push_back(getCurrentEra()); // (AI_getCurrEraFactor only depends on the era)
+	/*	Techs that the evaluation checks: resource reveal and trade techs, build
+		and feature techs. Whether we have them, could research them soon
+		(AIFoundValue::isNearTech) or a team member is researching them. */
+	{
+		std::vector<bool> abTechChecked(GC.getNumTechInfos(), false);
+		FOR_EACH_ENUM(Bonus)
+		{
+			CvBonusInfo const& kBonus = GC.getInfo(eLoopBonus);
+			if (kBonus.getTechReveal() != NO_TECH)
+				abTechChecked[kBonus.getTechReveal()] = true;
+			if (kBonus.getTechCityTrade() != NO_TECH)
+				abTechChecked[kBonus.getTechCityTrade()] = true;
+		}
+		FOR_EACH_ENUM(Build)
+		{
+			CvBuildInfo const& kBuild = GC.getInfo(eLoopBuild);
+			if (kBuild.getTechPrereq() != NO_TECH)
+				abTechChecked[kBuild.getTechPrereq()] = true;
+			FOR_EACH_ENUM(Feature)
+			{
+				if (kBuild.getFeatureTech(eLoopFeature) != NO_TECH)
+					abTechChecked[kBuild.getFeatureTech(eLoopFeature)] = true;
+			}
+		}
+		FOR_EACH_ENUM(Tech)
+		{
+			if (!abTechChecked[eLoopTech])
+				continue;
+			int iState = 0;
+			if (kOurTeam.isHasTech(eLoopTech))
+				iState = 4;
+			else
+			{
+				if (getCurrentResearch() == eLoopTech ||
+					canResearch(eLoopTech, false, false, true))
+				{
+					iState |= 2;
+				}
+				for (MemberIter it(getTeam()); it.hasNext(); ++it)
+				{
+					if (it->getCurrentResearch() == eLoopTech)
+						iState |= 1;
+				}
+			}
+			r.push_back(iState);
+		}
+	}
+	r.push_back(kOurTeam.isCapitulated());
+	r.push_back(countNumCoastalCities());
+	r.push_back(GC.getGame().getElapsedGameTurns() <= 5);
+	r.push_back(getCapital() == NULL ? -1 : kMap.plotNum(getCapital()->getPlot()));
+	r.push_back(getStartingPlot() == NULL ? -1 : kMap.plotNum(*getStartingPlot()));
+	FOR_EACH_ENUM(Yield)
+		r.push_back(getExtraYieldThreshold(eLoopYield));
+	FOR_EACH_ENUM(Improvement)
+		r.push_back(getImprovementCount(eLoopImprovement) > 0);
+	// Other civs
+	r.push_back(PlayerIter<CIV_ALIVE>::count());
+	for (PlayerIter<CIV_ALIVE> it; it.hasNext(); ++it)
+	{
+		CvPlayer const& kOther = *it;
+		r.push_back(kOther.getID());
+		r.push_back(kOurTeam.isHasMet(kOther.getTeam()));
+		r.push_back(GET_TEAM(kOther.getTeam()).isVassal(getTeam()));
+		r.push_back(kOurTeam.isVassal(kOther.getTeam()));
+		r.push_back(kOther.getFreeCityCommerce(COMMERCE_CULTURE));
+		r.push_back(kOther.getStartingPlot() == NULL ? -1 :
+				kMap.plotNum(*kOther.getStartingPlot()));
+		if (!kOurTeam.isHasMet(kOther.getTeam()))
+			continue;
+		// Cities that affect the foreign proximity and the distance to our cities
+		FOR_EACH_CITY(pCity, kOther)
+		{
+			if (kOther.getTeam() == getTeam() || kOurTeam.AI_deduceCitySite(*pCity))
+				r.push_back(kMap.plotNum(pCity->getPlot()));
+		}
+		r.push_back(-1);
+	}
+	// Areas
+	FOR_EACH_AREA(pArea)
+	{
+		r.push_back(pArea->getID());
+		r.push_back(pArea->getNumTiles());
+		r.push_back(pArea->getNumStartingPlots() > 0);
+		r.push_back(pArea->getNumCities() > 0);
+		r.push_back(pArea->getNumCivCities());
+		if (pArea->getNumCivCities() <= 0)
+		{	// Only matters between 35 and 55 (AIFoundValue::adjustToCitiesPerArea)
+			r.push_back(range(pArea->getNumRevealedTiles(getTeam()), 35, 55));
+		}
+		for (PlayerIter<CIV_ALIVE> it; it.hasNext(); ++it)
+		{
+			int iCities = pArea->getCitiesPerPlayer(it->getID());
+			r.push_back(it->getID() == getID() ? iCities : std::min(iCities, 2));
+		}
+		if (pArea->isWater())
+			r.push_back(kOurTeam.AI_isWaterAreaRelevant(*pArea));
+	}
+}
+
+/*	advc.opt: Inputs of the city site evaluation that only matter to the sites
+	near a resource of a given type; the same number of values per resource. */
+void CvPlayerAI::AI_getFoundValueBonusInputs(std::vector<int>& r) const
+{
+	PROFILE_FUNC();
+	FOR_EACH_ENUM(Bonus)
+	{
+		r.push_back(getNumAvailableBonuses(eLoopBonus));
+		r.push_back(getNumTradeableBonuses(eLoopBonus));
+		r.push_back(AI_bonusVal(eLoopBonus, 1, true));
+		bool bOwned = false;
+		if (getNumAvailableBonuses(eLoopBonus) <= 0)
+		{
+			FOR_EACH_CITYAI(pCity, *this)
+			{
+				if (pCity->AI_countNumBonuses(eLoopBonus, true, true, -1) > 0)
+				{
+					bOwned = true;
+					break;
+				}
+			}
+		}
+		r.push_back(bOwned);
+	}
+}
+
 
 void CvPlayerAI::AI_updateAreaTargets()
 {
@@ -1317,25 +1553,29 @@ void CvPlayerAI::AI_unitUpdate()
 			bool bRepeat = true;
 			do
 			{
-				std::vector<std::pair<int, int> > groupList;
-
+				/*std::vector<std::pair<int, int> > groupList;
 				pCurrUnitNode = headGroupCycleNode();
-				while (pCurrUnitNode != NULL)
-				{
+				while (pCurrUnitNode != NULL) {
 					CvSelectionGroupAI* pLoopSelectionGroup = AI_getSelectionGroup(
 							pCurrUnitNode->m_data);
 					int iPriority = AI_movementPriority(*pLoopSelectionGroup);
 					groupList.push_back(std::make_pair(iPriority, pCurrUnitNode->m_data));
-
 					pCurrUnitNode = nextGroupCycleNode(pCurrUnitNode);
 				}
 				FAssert(groupList.size() == getNumSelectionGroups());
-
-				std::sort(groupList.begin(), groupList.end());
-				for (size_t i = 0; i < groupList.size(); i++)
+				std::sort(groupList.begin(), groupList.end());*/
+				/*	<advc.opt> Only re-key the groups that have changed. Group updates
+					only mark groups as dirty, so the queue stays intact while
+					we traverse it. */
+				AI_updateMovementPriorityQueue();
+				int const iQueued = (int)m_movementPriorityQueue.size();
+				FAssert(iQueued == getNumSelectionGroups());
+				for (std::set<std::pair<int,int> >::const_iterator it =
+					m_movementPriorityQueue.begin();
+					it != m_movementPriorityQueue.end(); ++it)
 				{
 					CvSelectionGroupAI* pLoopSelectionGroup = AI_getSelectionGroup(
-							groupList[i].second);
+							it->second); // </advc.opt>
 					/*	I think it's probably a good idea to activate automissions here,
 						so that the move priority is respected even for commands
 						issued on the previous turn. (This will allow reserve units to
@@ -1359,7 +1599,7 @@ void CvPlayerAI::AI_unitUpdate()
 					then lets try to take care of the new groups right away.
 					(there might be a faster way to look for the new groups,
 					but I don't know it.) */
-				bRepeat = bRepeat && m_groupCycle.getLength() > (int)groupList.size();
+				bRepeat = bRepeat && m_groupCycle.getLength() > iQueued; // advc.opt
 				/*	the repeat will do a stack of redundant checks,
 					but I still expect it to be much faster
 					than waiting for the next turnslice.
@@ -1374,6 +1614,74 @@ void CvPlayerAI::AI_unitUpdate()
 }
 
 
+// advc.opt:
+void CvPlayerAI::AI_setMovementPriorityDirty(int iGroupID)
+{
+	/*	Don't keep track while the queue is going to be rebuilt anyway
+		(e.g. while this player is human) */
+	if (m_iMovementPriorityTurn == GC.getGame().getGameTurn())
+		m_aiMovementPriorityDirty.push_back(iGroupID);
+}
+
+/*	advc.opt: Bring the keys of m_movementPriorityQueue up to date. Apart from
+	the group's units and mission AI, AI_movementPriority depends only on
+	the best land unit combat in the game and on whether we have any cities,
+	so a change in either of those triggers a rebuild. */
+void CvPlayerAI::AI_updateMovementPriorityQueue()
+{
+	PROFILE_FUNC();
+	CvGame const& kGame = GC.getGame();
+	if (m_iMovementPriorityTurn != kGame.getGameTurn() ||
+		m_iMovementPriorityBestCombat != kGame.getBestLandUnitCombat() ||
+		m_bMovementPriorityCities != (getNumCities() > 0))
+	{
+		m_movementPriorityQueue.clear();
+		m_movementPriorityKeys.clear();
+		m_aiMovementPriorityDirty.clear();
+		m_iMovementPriorityTurn = kGame.getGameTurn();
+		m_iMovementPriorityBestCombat = kGame.getBestLandUnitCombat();
+		m_bMovementPriorityCities = (getNumCities() > 0);
+		FOR_EACH_GROUPAI(pGroup, *this)
+		{
+			int const iPriority = AI_movementPriority(*pGroup);
+			m_movementPriorityQueue.insert(std::make_pair(iPriority, pGroup->getID()));
+			m_movementPriorityKeys[pGroup->getID()] = iPriority;
+		}
+		return;
+	}
+	for (size_t i = 0; i < m_aiMovementPriorityDirty.size(); i++)
+	{
+		int const iID = m_aiMovementPriorityDirty[i];
+		std::map<int,int>::iterator itKey = m_movementPriorityKeys.find(iID);
+		CvSelectionGroupAI const* pGroup = AI_getSelectionGroup(iID);
+		if (itKey != m_movementPriorityKeys.end())
+		{
+			if (pGroup != NULL)
+			{
+				int const iPriority = AI_movementPriority(*pGroup);
+				if (iPriority == itKey->second)
+					continue;
+				m_movementPriorityQueue.erase(std::make_pair(itKey->second, iID));
+				m_movementPriorityQueue.insert(std::make_pair(iPriority, iID));
+				itKey->second = iPriority;
+			}
+			else
+			{
+				m_movementPriorityQueue.erase(std::make_pair(itKey->second, iID));
+				m_movementPriorityKeys.erase(itKey);
+			}
+		}
+		else if (pGroup != NULL)
+		{
+			int const iPriority = AI_movementPriority(*pGroup);
+			m_movementPriorityQueue.insert(std::make_pair(iPriority, iID));
+			m_movementPriorityKeys[iID] = iPriority;
+		}
+	}
+	m_aiMovementPriorityDirty.clear();
+}
+
+
 void CvPlayerAI::AI_makeAssignWorkDirty()
 {
 	FOR_EACH_CITYAI_VAR(pLoopCity, *this)
@@ -3361,84 +3669,86 @@ int CvPlayerAI::AI_getPlotDanger(/* BtS parameters: */ CvPlot const& kPlot, int
 		}
 	}
 	CvArea const& kPlotArea = kPlot.getArea();
+	/*	advc.opt: Border danger only extends to BORDER_DANGER_RANGE; check it in a
+		separate, smaller loop so that the unit counts can be cached. */
+	int const iBorderRange = std::min(iRange, (int)BORDER_DANGER_RANGE);
 	// advc: The iterator is a little slower and we don't benefit here from a spiral pattern
 	//for (SquareIter it(kPlot, iRange); it.hasNext(); ++it) { CvPlot const& p = *it;
-	for (int iDX = -iRange; iDX <= iRange; iDX++)
-	for (int iDY = -iRange; iDY <= iRange; iDY++)
+	for (int iDX = -iBorderRange; bCheckBorder && iDX <= iBorderRange; iDX++)
+	for (int iDY = -iBorderRange; bCheckBorder && iDY <= iBorderRange; iDY++)
 	{
 		CvPlot const* pp = plotXY(&kPlot, iDX, iDY);
 		if (pp == NULL) continue;
 		CvPlot const& p = *pp;
-		if (p.isArea(kPlotArea))
-		{
-			if (bCheckBorder)
-			{
-				//if (p.getTeam() != NO_TEAM && GET_TEAM(getTeam()).isAtWar(p.getTeam())
-				// <advc.001i>
-				PlayerTypes const eRevealedLoopPlayer = p.getRevealedOwner(eTeam);
-				if (eRevealedLoopPlayer != NO_PLAYER &&
-					GET_TEAM(getTeam()).isAtWar(TEAMID(eRevealedLoopPlayer)) &&
-					// </advc.001i>
-					eRevealedLoopPlayer != BARBARIAN_PLAYER) // advc.300
-				{
-					int const iDistance = stepDistance(&kPlot, &p);
-					//if (iDistance == 1)
-					// <advc> Let's also cache border danger when kPlot itself is hostile
-					BOOST_STATIC_ASSERT(BORDER_DANGER_RANGE >= 1);
-					bool const bInRange = (iDistance < BORDER_DANGER_RANGE);
-					bool const bInRangeThroughRoute = (iDistance == BORDER_DANGER_RANGE &&
-							// advc.001i:
-							p./*isRoute()*/getRevealedRouteType(eTeam) != NO_ROUTE);
-					if (bInRange || bInRangeThroughRoute) // </advc>
+		if (!p.isArea(kPlotArea))
+			continue;
+		//if (p.getTeam() != NO_TEAM && GET_TEAM(getTeam()).isAtWar(p.getTeam())
+		// <advc.001i>
+		PlayerTypes const eRevealedLoopPlayer = p.getRevealedOwner(eTeam);
+		if (eRevealedLoopPlayer != NO_PLAYER &&
+			GET_TEAM(getTeam()).isAtWar(TEAMID(eRevealedLoopPlayer)) &&
+			// </advc.001i>
+			eRevealedLoopPlayer != BARBARIAN_PLAYER) // advc.300
+		{
+			int const iDistance = stepDistance(&kPlot, &p);
+			//if (iDistance == 1)
+			// <advc> Let's also cache border danger when kPlot itself is hostile
+			BOOST_STATIC_ASSERT(BORDER_DANGER_RANGE >= 1);
+			bool const bInRange = (iDistance < BORDER_DANGER_RANGE);
+			bool const bInRangeThroughRoute = (iDistance == BORDER_DANGER_RANGE &&
+					// advc.001i:
+					p./*isRoute()*/getRevealedRouteType(eTeam) != NO_ROUTE);
+			if (bInRange || bInRangeThroughRoute) // </advc>
+			{
+				kPlot.setBorderDangerCache(eTeam, true);
+				// p is in enemy territory, so this is fine.
+				p.setBorderDangerCache(eTeam, true);
+				// BBAI: "Border cache is reversible, set for both team and enemy."
+				/*	K-Mod: reversible my arse.
+					only set the cache for eLoopTeam if kPlot is owned by us!
+					(ie. owned by their enemy) */
+				// <advc.001i> Only if eLoopTeam knows that we own it
+				TeamTypes eActualLoopTeam = p.getTeam();
+				if (eActualLoopTeam != NO_TEAM)
+				{
+					PlayerTypes eRevealedPlotOwner = kPlot.getRevealedOwner(
+							eActualLoopTeam);
+					if (eRevealedPlotOwner != NO_PLAYER &&
+						TEAMID(eRevealedPlotOwner) == eTeam && // </advc.001i>
+						(bInRange || (kPlot.//isRoute()
+						// advc.001i:
+						getRevealedRouteType(eActualLoopTeam) != NO_ROUTE &&
+						kPlot.getTeam() == eTeam)))
 					{
-						kPlot.setBorderDangerCache(eTeam, true);
-						// p is in enemy territory, so this is fine.
-						p.setBorderDangerCache(eTeam, true);
-						// BBAI: "Border cache is reversible, set for both team and enemy."
-						/*	K-Mod: reversible my arse.
-							only set the cache for eLoopTeam if kPlot is owned by us!
-							(ie. owned by their enemy) */
-						// <advc.001i> Only if eLoopTeam knows that we own it
-						TeamTypes eActualLoopTeam = p.getTeam();
-						if (eActualLoopTeam != NO_TEAM)
-						{
-							PlayerTypes eRevealedPlotOwner = kPlot.getRevealedOwner(
-									eActualLoopTeam);
-							if (eRevealedPlotOwner != NO_PLAYER &&
-								TEAMID(eRevealedPlotOwner) == eTeam && // </advc.001i>
-								(bInRange || (kPlot.//isRoute()
-								// advc.001i:
-								getRevealedRouteType(eActualLoopTeam) != NO_ROUTE &&
-								kPlot.getTeam() == eTeam)))
-							{
-								p.setBorderDangerCache(eActualLoopTeam, true);
-								kPlot.setBorderDangerCache(eActualLoopTeam, true);
-							}
-						}  // <advc>
-						r++;
-						if (r >= iLimit)
-							return iLimit;
-						// Count at most 1 for border danger
-						bCheckBorder = false; 
+						p.setBorderDangerCache(eActualLoopTeam, true);
+						kPlot.setBorderDangerCache(eActualLoopTeam, true);
 					}
-				}
-			}
-			if (p.isUnit()) // Redundant but fast (inlined)
-			{
-				// Code moved into auxiliary function
-				r += AI_countDangerousUnits(p, kPlot, bTestMoves, iLimit, eAttackPlayer);
+				}  // <advc>
+				r++;
 				if (r >= iLimit)
 					return iLimit;
-			} // </advc>
+				// Count at most 1 for border danger
+				bCheckBorder = false; 
+			}
 		}
-		/*	<advc.030> Same-area no longer rules out a (visible) submarine -
-			but is this really ever going to be a problem? */
-		/*else if (p.isUnit() && kPlotArea.canBeEntered(p.getArea()))
+	}
+	// <advc.opt>
+	if (iRange == DANGER_RANGE && eAttackPlayer == NO_PLAYER)
+	{
+		DangerCacheSlot const eSlot = (bTestMoves ? DANGER_CACHE_TEST_MOVES :
+				DANGER_CACHE_NO_TEST_MOVES);
+		int const iUnitLimit = iLimit - r;
+		int iUnits = AI_cachedDangerCount(kPlot, eSlot, iUnitLimit);
+		if (iUnits < 0)
 		{
-			r += AI_countDangerousUnits(p, kPlot, bTestMoves, 1, eAttackPlayer);
-			// ... (copy from above)
-		}*/ // </advc.030>
+			iUnits = AI_countPlotDangerUnits(kPlot, iRange, bTestMoves,
+					iUnitLimit, eAttackPlayer);
+			AI_cacheDangerCount(kPlot, eSlot, iUnits, iUnitLimit);
+		}
+		r += iUnits;
 	}
+	else r += AI_countPlotDangerUnits(kPlot, iRange, bTestMoves, iLimit - r, eAttackPlayer);
+	// </advc.opt>
 
 	/*	The test moves case is a strict subset of the more general case,
 		either is appropriate for setting the cache.  However, since the test moves
@@ -3458,6 +3768,98 @@ int CvPlayerAI::AI_getPlotDanger(/* BtS parameters: */ CvPlot const& kPlot, int
 	return std::min(r, iLimit); // advc.104: May have counted past the limit
 }
 
+/*	advc.opt: Cut from AI_getPlotDanger. Units within iRange of kPlot that
+	could attack kPlot; border danger isn't counted here. */
+int CvPlayerAI::AI_countPlotDangerUnits(CvPlot const& kPlot, int iRange,
+	bool bTestMoves, int iLimit, PlayerTypes eAttackPlayer) const
+{
+	FAssert(iLimit > 0);
+	CvArea const& kPlotArea = kPlot.getArea();
+	int r = 0;
+	for (int iDX = -iRange; iDX <= iRange; iDX++)
+	for (int iDY = -iRange; iDY <= iRange; iDY++)
+	{
+		CvPlot const* pp = plotXY(&kPlot, iDX, iDY);
+		if (pp == NULL) continue;
+		CvPlot const& p = *pp;
+		if (p.isArea(kPlotArea))
+		{
+			if (p.isUnit()) // Redundant but fast (inlined)
+			{
+				r += AI_countDangerousUnits(p, kPlot, bTestMoves, iLimit - r, eAttackPlayer);
+				if (r >= iLimit)
+					return iLimit;
+			}
+		}
+		/*	<advc.030> Same-area no longer rules out a (visible) submarine -
+			but is this really ever going to be a problem? */
+		/*else if (p.isUnit() && kPlotArea.canBeEntered(p.getArea()))
+		{
+			r += AI_countDangerousUnits(p, kPlot, bTestMoves, 1, eAttackPlayer);
+			// ... (copy from above)
+		}*/ // </advc.030>
+	}
+	return r;
+}
+
+/*	advc.opt: Returns -1 if no count for eSlot is cached at kPlot or if the
+	cached count was cut off at a limit lower than iLimit. */
+int CvPlayerAI::AI_cachedDangerCount(CvPlot const& kPlot, DangerCacheSlot eSlot,
+	int iLimit) const
+{
+	if (m_aDangerCache.empty())
+		return -1;
+	DangerCacheEntry const& kEntry = m_aDangerCache[
+			GC.getMap().plotNum(kPlot) * NUM_DANGER_CACHE_SLOTS + eSlot];
+	if (kEntry.iEpoch != m_iDangerCacheEpoch ||
+		(!m_aiDangerPlotStamps.empty() &&
+		kEntry.iStamp < m_aiDangerPlotStamps[GC.getMap().plotNum(kPlot)]))
+	{
+		return -1;
+	}
+	if (kEntry.bExact)
+		return std::min<int>(kEntry.iCount, iLimit);
+	if (kEntry.iCount >= iLimit)
+		return iLimit;
+	return -1;
+}
+
+// advc.opt: iCount is the result of counting with limit iLimit
+void CvPlayerAI::AI_cacheDangerCount(CvPlot const& kPlot, DangerCacheSlot eSlot,
+	int iCount, int iLimit) const
+{
+	CvMap const& kMap = GC.getMap();
+	if (m_aDangerCache.empty())
+	{
+		DangerCacheEntry kInvalid;
+		kInvalid.iEpoch = -1;
+		kInvalid.iStamp = -1;
+		kInvalid.iCount = 0;
+		kInvalid.bExact = false;
+		m_aDangerCache.resize(kMap.numPlots() * NUM_DANGER_CACHE_SLOTS, kInvalid);
+	}
+	FAssert((int)m_aDangerCache.size() == kMap.numPlots() * NUM_DANGER_CACHE_SLOTS);
+	DangerCacheEntry& kEntry = m_aDangerCache[
+			kMap.plotNum(kPlot) * NUM_DANGER_CACHE_SLOTS + eSlot];
+	kEntry.iEpoch = m_iDangerCacheEpoch;
+	kEntry.iStamp = m_iDangerStamp;
+	kEntry.iCount = toShort(std::min(iCount, (int)MAX_SHORT));
+	kEntry.bExact = (iCount < iLimit);
+}
+
+/*	advc.opt: The cached counts at a plot only consider units and visibility
+	within DANGER_RANGE (the path check in AI_countDangerousUnits for nearby
+	human units can look a bit farther; that much imprecision is tolerable). */
+void CvPlayerAI::AI_invalidateDangerCache(CvPlot const& kPlot)
+{
+	CvMap const& kMap = GC.getMap();
+	if ((int)m_aiDangerPlotStamps.size() != kMap.numPlots())
+		m_aiDangerPlotStamps.assign(kMap.numPlots(), 0);
+	m_iDangerStamp++;
+	for (SquareIter it(kPlot, DANGER_RANGE); it.hasNext(); ++it)
+		m_aiDangerPlotStamps[kMap.plotNum(*it)] = m_iDangerStamp;
+}
+
 // advc: from AI_getAnyPlotDanger
 int CvPlayerAI::AI_countDangerousUnits(CvPlot const& kAttackerPlot, CvPlot const& kDefenderPlot,
 	bool bTestMoves, int iLimit, /* advc.104: */ PlayerTypes eAttackPlayer) const
@@ -3542,8 +3944,23 @@ int CvPlayerAI::AI_getWaterDanger(CvPlot const& kPlot, int iRange,
 	PROFILE_FUNC();
 	FAssert(iMaxCount > 0); // advc.opt (use MAX_INT for infinity)
 	FAssert(iRange >= 0); // advc: -1 no longer used for default range
+	// <advc.opt>
+	if (iRange != DANGER_RANGE)
+		return AI_countWaterDangerUnits(kPlot, iRange, iMaxCount);
+	int iCount = AI_cachedDangerCount(kPlot, DANGER_CACHE_WATER, iMaxCount);
+	if (iCount < 0)
+	{
+		iCount = AI_countWaterDangerUnits(kPlot, iRange, iMaxCount);
+		AI_cacheDangerCount(kPlot, DANGER_CACHE_WATER, iCount, iMaxCount);
+	}
+	return iCount;
+}
 
-	int iCount = 0;
+// advc.opt: Cut from AI_getWaterDanger
+int CvPlayerAI::AI_countWaterDangerUnits(CvPlot const& kPlot, int iRange,
+	int iMaxCount) const
+{
+	int iCount = 0; // </advc.opt>
 	for (SquareIter it(kPlot, iRange); it.hasNext(); ++it)
 	{
 		CvPlot const& p = *it;
@@ -7372,6 +7789,7 @@ void CvPlayerAI::AI_changeCachedAttitude(PlayerTypes ePlayer, int iChange)
 {
 	FAssert(ePlayer >= 0 && ePlayer < MAX_PLAYERS);
 	m_aiAttitude[ePlayer] += iChange;
+	AI_invalidateTradeValCache(); // advc.opt
 } // K-Mod end
 
 /*  advc.130w: Gained and lost cities may change expansionist hate and perhaps other
@@ -8413,16 +8831,18 @@ PlayerVoteTypes CvPlayerAI::AI_diploVote(const VoteSelectionSubData& kVoteData,
 	bool bDefy = false;
 	bool bValid = true;
 
+	CivicValueMap aiCivicValue; // advc.opt
 	FOR_EACH_ENUM(Civic)
 	{
 		if (!GC.getInfo(eVote).isForceCivic(eLoopCivic) || isCivic(eLoopCivic))
 			continue;
-		CivicTypes eBestCivic = AI_bestCivic(GC.getInfo(eLoopCivic).getCivicOptionType());
+		CivicTypes eBestCivic = AI_bestCivic(GC.getInfo(eLoopCivic).getCivicOptionType(),
+				NULL, aiCivicValue); // advc.opt
 		if (eBestCivic == NO_CIVIC || eBestCivic == eLoopCivic)
 			continue;
 
-		int iBestCivicValue = AI_civicValue(eBestCivic);
-		int iNewCivicValue = AI_civicValue(eLoopCivic);
+		int iBestCivicValue = AI_civicValue(eBestCivic, aiCivicValue);
+		int iNewCivicValue = AI_civicValue(eLoopCivic, aiCivicValue);
 		// BETTER_BTS_AI_MOD, Diplomacy AI, 12/30/08, jdog5000: START
 		// Increase threshold of voting for friend's proposal
 		if (bFriendlyToSecretary)
@@ -11640,6 +12060,12 @@ int CvPlayerAI::AI_bonusTradeVal(BonusTypes eBonus, PlayerTypes eFromPlayer, int
 {
 	PROFILE_FUNC();
 	FAssert(eFromPlayer != getID());
+	// <advc.opt>
+	int* piCached = AI_bonusTradeValCacheEntry(eBonus, eFromPlayer,
+			bExtraHappyOrHealth ? 0 : iChange);
+	if (piCached != NULL && *piCached != MIN_INT)
+		return *piCached;
+	int const iCacheEpoch = m_iTradeValCacheEpoch; // </advc.opt>
 	bool bUseOurBonusVal = true;
 	if(isHuman())
 	{
@@ -11789,7 +12215,31 @@ int CvPlayerAI::AI_bonusTradeVal(BonusTypes eBonus, PlayerTypes eFromPlayer, int
 	{
 		iR = ::roundToMultiple(iR, 4);
 	}
-	return iR *  GC.getDefineINT(CvGlobals::PEACE_TREATY_LENGTH);
+	iR *= GC.getDefineINT(CvGlobals::PEACE_TREATY_LENGTH);
+	/*	advc.opt: Don't store the result if the evaluation has (indirectly)
+		invalidated the cache; the value may be based on outdated inputs. */
+	if (piCached != NULL && iCacheEpoch == m_iTradeValCacheEpoch)
+		*piCached = iR;
+	return iR;
+}
+
+// advc.opt: NULL if the value can't be cached
+int* CvPlayerAI::AI_bonusTradeValCacheEntry(BonusTypes eBonus, PlayerTypes eFromPlayer,
+	int iChange) const
+{
+	if (!m_bTradeValCacheActive || (iChange != 1 && iChange != -1) ||
+		eFromPlayer >= MAX_CIV_PLAYERS)
+	{
+		return NULL;
+	}
+	int const iBonuses = GC.getNumBonusInfos();
+	if (m_iBonusTradeValCacheEpoch != m_iTradeValCacheEpoch)
+	{
+		m_aiBonusTradeValCache.assign(MAX_CIV_PLAYERS * iBonuses * 2, MIN_INT);
+		m_iBonusTradeValCacheEpoch = m_iTradeValCacheEpoch;
+	}
+	return &m_aiBonusTradeValCache[(eFromPlayer * iBonuses + eBonus) * 2 +
+			(iChange > 0 ? 1 : 0)];
 }
 
 
@@ -12832,11 +13282,14 @@ int CvPlayerAI::AI_civicTradeVal(CivicTypes eCivic, PlayerTypes ePlayer) const
 	// advc.132: Replacing the above
 	int iAnarchyCost = kPlayer.AI_anarchyTradeVal(eCivic);
 
-	CivicTypes eBestCivic = kPlayer.AI_bestCivic(GC.getInfo(eCivic).getCivicOptionType());
+	CivicValueMap aiCivicValue; // advc.opt
+	CivicTypes eBestCivic = kPlayer.AI_bestCivic(GC.getInfo(eCivic).getCivicOptionType(),
+			NULL, aiCivicValue);
 	if (eBestCivic != NO_CIVIC && eBestCivic != eCivic)
 	{
 		iValue += //std::max(0, // advc.132: Handle that below
-				2 * (kPlayer.AI_civicValue(eBestCivic) - kPlayer.AI_civicValue(eCivic))
+				2 * (kPlayer.AI_civicValue(eBestCivic, aiCivicValue) -
+				kPlayer.AI_civicValue(eCivic, aiCivicValue))
 				/*	advc.132: AI_civicValue is at a scale of 1 commerce per turn.
 					ePlayer will have to run the new civic for longer than 2 turns ...
 					2*MIN_REVOLUTION_TURNS is consistent with the end of AI_doCivics. */
@@ -14195,11 +14648,13 @@ int CvPlayerAI::AI_countUnimprovedBonuses(CvArea const& kArea, CvPlot* pFromPlot
 
 	int iCount = 0;
 	CvMap const& kMap = GC.getMap();
+	CvMap::PlotFields const& kFields = kMap.getPlotFields(); // advc.opt
 	for (int i = 0; i < kMap.numPlots(); i++)
 	{
-		CvPlot const& kPlot = kMap.getPlotByIndex(i);
-		if (kPlot.getOwner() == getID() && kPlot.isArea(kArea))
+		// advc.opt: Was kPlot.getOwner() == getID() && kPlot.isArea(kArea)
+		if (kFields.getOwner(i) == getID() && kFields.getAreaID(i) == kArea.getID())
 		{	// advc.042: Remaining checks moved into auxiliary function
+			CvPlot const& kPlot = kMap.getPlotByIndex(i);
 			if(AI_isUnimprovedBonus(kPlot, pFromPlot, true))
 				iCount++;
 		}
@@ -15252,53 +15707,92 @@ int CvPlayerAI::AI_localDefenceStrength(const CvPlot* pDefencePlot, TeamTypes eD
 			continue;
 
 		int iPlotTotal = 0;
-		FOR_EACH_UNITAI_IN(pLoopUnit, p)
-		{
-			CvUnitAI const& kUnit = *pLoopUnit;
-			// <advc.opt>
-			if (!kUnit.canFight())
-				continue; // </advc.opt>
-			// advc (note): This doesn't respect hidden nationality
-			if (kUnit.getTeam() == eDefenceTeam ||
-				(eDefenceTeam != NO_TEAM &&
-				GET_TEAM(kUnit.getTeam()).isVassal(eDefenceTeam)) ||
-				(eDefenceTeam == NO_TEAM &&
-				GET_TEAM(getTeam()).AI_mayAttack(kUnit.getTeam())))
-			{
-				if (eDomainType != NO_DOMAIN && kUnit.getDomainType() != eDomainType)
-					continue;
+		/*	<advc.opt> Units that defend in place don't depend on the target;
+			can cache their strength. */
+		bool const bCacheable = (!bCheckMoves && !bPredictPromotions &&
+				(!bMoveToTarget || &p == pDefencePlot));
+		if (bCacheable && (int)m_aDefenceCache.size() != GC.getMap().numPlots())
+		{
+			DefenceCacheEntry kInvalid;
+			kInvalid.iEpoch = -1;
+			kInvalid.iStrength = 0;
+			kInvalid.iDefenders = 0;
+			kInvalid.eDefenceTeam = NO_TEAM;
+			kInvalid.eDomain = NO_DOMAIN;
+			m_aDefenceCache.assign(GC.getMap().numPlots(), kInvalid);
+		}
+		DefenceCacheEntry* pCacheEntry = (!bCacheable ? NULL :
+				&m_aDefenceCache[GC.getMap().plotNum(p)]);
+		bool const bCached = (pCacheEntry != NULL &&
+				pCacheEntry->iEpoch == AI_getCombatCacheEpoch() &&
+				pCacheEntry->eDefenceTeam == eDefenceTeam &&
+				pCacheEntry->eDomain == eDomainType);
+		if (bCached)
+		{
+			iPlotTotal = pCacheEntry->iStrength;
+			iDefenders += pCacheEntry->iDefenders;
+		} // </advc.opt>
+		if (!bCached)
+		{
+			int const iOldDefenders = iDefenders; // advc.opt
+			FOR_EACH_UNITAI_IN(pLoopUnit, p)
+			{
+				CvUnitAI const& kUnit = *pLoopUnit;
 				// <advc.opt>
-				if (kUnit.isDead())
+				if (!kUnit.canFight())
 					continue; // </advc.opt>
-				if (bCheckMoves)
-				{
-					/*	Unfortunately, we can't use the global pathfinder here
-						- because the calling function might be waiting
-						to use some pathfinding results.
-						So this check will have to be really rough. :( */
-					int iMoves = kUnit.baseMoves();
-					if (p.isValidRoute(&kUnit, /* advc.001i: */ false))
-						iMoves++;
-					if (it.currStepDist() > iMoves)
-						continue; // can't make it. (maybe?)
-				}
-				// <advc.139>
-				int iHP = kUnit.currHitPoints();
-				bool const bAssumePromo = (bPredictPromotions && kUnit.isPromotionReady());
-				if (bAssumePromo && kUnit.getDamage() > 0)
-				{
-					iHP += kUnit.promotionHeal();
-					iHP = std::min(kUnit.maxHitPoints(), iHP);
-				} // </advc.139>
-				/*  <advc.159> Call AI_currEffectiveStr instead of currEffectiveStr.
-					Adjustments for first strikes are handled by that new function. */
-				int const iUnitStr = kUnit.AI_currEffectiveStr(
-						bMoveToTarget ? pDefencePlot : &p, // </advc.159>
-						NULL, false, 0, false, iHP, bAssumePromo); // advc.139
-				iPlotTotal += iUnitStr;
-				iDefenders++; // advc.159
+				// advc (note): This doesn't respect hidden nationality
+				if (kUnit.getTeam() == eDefenceTeam ||
+					(eDefenceTeam != NO_TEAM &&
+					GET_TEAM(kUnit.getTeam()).isVassal(eDefenceTeam)) ||
+					(eDefenceTeam == NO_TEAM &&
+					GET_TEAM(getTeam()).AI_mayAttack(kUnit.getTeam())))
+				{
+					if (eDomainType != NO_DOMAIN && kUnit.getDomainType() != eDomainType)
+						continue;
+					// <advc.opt>
+					if (kUnit.isDead())
+						continue; // </advc.opt>
+					if (bCheckMoves)
+					{
+						/*	Unfortunately, we can't use the global pathfinder here
+							- because the calling function might be waiting
+							to use some pathfinding results.
+							So this check will have to be really rough. :( */
+						int iMoves = kUnit.baseMoves();
+						if (p.isValidRoute(&kUnit, /* advc.001i: */ false))
+							iMoves++;
+						if (it.currStepDist() > iMoves)
+							continue; // can't make it. (maybe?)
+					}
+					// <advc.139>
+					int iHP = kUnit.currHitPoints();
+					bool const bAssumePromo = (bPredictPromotions && kUnit.isPromotionReady());
+					if (bAssumePromo && kUnit.getDamage() > 0)
+					{
+						iHP += kUnit.promotionHeal();
+						iHP = std::min(kUnit.maxHitPoints(), iHP);
+					} // </advc.139>
+					/*  <advc.159> Call AI_currEffectiveStr instead of currEffectiveStr.
+						Adjustments for first strikes are handled by that new function. */
+					int const iUnitStr = kUnit.AI_currEffectiveStr(
+							bMoveToTarget ? pDefencePlot : &p, // </advc.159>
+							NULL, false, 0, false, iHP, bAssumePromo); // advc.139
+					iPlotTotal += iUnitStr;
+					iDefenders++; // advc.159
+				}
 			}
+			// <advc.opt>
+			if (pCacheEntry != NULL)
+			{
+				pCacheEntry->iEpoch = AI_getCombatCacheEpoch();
+				pCacheEntry->iStrength = iPlotTotal;
+				pCacheEntry->iDefenders = toShort(iDefenders - iOldDefenders);
+				pCacheEntry->eDefenceTeam = (char)eDefenceTeam;
+				pCacheEntry->eDomain = (char)eDomainType;
+			} // </advc.opt>
 		}
+
 		/*	since we're here, we might as well update our memory.
 			(human players don't track strength memory)
 			advc.158: They do track it now (unless bNoCache). But not the Barbarians.
@@ -15685,6 +16179,14 @@ int CvPlayerAI::AI_wakePlotTargetMissionAIs(/* advc: const& */ CvPlot const& kPl
 
 // K-Mod, I've added piBestValue, and tidied up some stuff.
 CivicTypes CvPlayerAI::AI_bestCivic(CivicOptionTypes eCivicOption, int* piBestValue) const
+{
+	CivicValueMap kCache; // advc.opt
+	return AI_bestCivic(eCivicOption, piBestValue, kCache);
+}
+
+// advc.opt: Body moved from the function above
+CivicTypes CvPlayerAI::AI_bestCivic(CivicOptionTypes eCivicOption, int* piBestValue,
+	CivicValueMap& kCache) const
 {
 	CivicTypes eBestCivic = NO_CIVIC;
 	int iBestValue = MIN_INT;
@@ -15694,7 +16196,7 @@ CivicTypes CvPlayerAI::AI_bestCivic(CivicOptionTypes eCivicOption, int* piBestVa
 		{
 			if (canDoCivics(eLoopCivic))
 			{
-				int iValue = AI_civicValue(eLoopCivic);
+				int iValue = AI_civicValue(eLoopCivic, kCache);
 				if (iValue > iBestValue)
 				{
 					iBestValue = iValue;
@@ -15708,6 +16210,21 @@ CivicTypes CvPlayerAI::AI_bestCivic(CivicOptionTypes eCivicOption, int* piBestVa
 	return eBestCivic;
 }
 
+// advc.opt:
+int CvPlayerAI::AI_civicValue(CivicTypes eCivic, CivicValueMap& kCache) const
+{
+	if (eCivic == NO_CIVIC)
+		return AI_civicValue(eCivic);
+	int iValue = kCache.get(eCivic);
+	if (iValue == MIN_INT)
+	{
+		iValue = AI_civicValue(eCivic);
+		FAssert(iValue != MIN_INT);
+		kCache.set(eCivic, iValue);
+	}
+	return iValue;
+}
+
 /*	The bulk of this function has been rewritten for K-Mod.
 	(some original code deleted, some edited by BBAI)
 	Note: the value is roughly in units of 1 commerce per turn.
@@ -18161,11 +18678,14 @@ int CvPlayerAI::AI_calculateGoldenAgeValue(bool bConsiderRevolution) const
 	{
 		CivicMap aeBestCivics;
 		getCivics(aeBestCivics); // Start with copy of current civics
+		CivicValueMap aiCivicValue; // advc.opt
 		FOR_EACH_ENUM(CivicOption)
 		{
-			int iCurrentValue = AI_civicValue(aeBestCivics.get(eLoopCivicOption));
+			int iCurrentValue = AI_civicValue(aeBestCivics.get(eLoopCivicOption),
+					aiCivicValue); // advc.opt
 			int iBestValue;
-			CivicTypes eNewCivic = AI_bestCivic(eLoopCivicOption, &iBestValue);
+			CivicTypes eNewCivic = AI_bestCivic(eLoopCivicOption, &iBestValue,
+					aiCivicValue); // advc.opt
 
 			// using a 10 percent threshold. (cf the higher threshold used in AI_doCivics)
 			if (aeBestCivics.get(eLoopCivicOption) != NO_CIVIC &&
@@ -19101,11 +19621,14 @@ void CvPlayerAI::AI_doCivics()
 
 	CivicMap aeBestCivic;
 	getCivics(aeBestCivic);
+	/*	advc.opt: Our civic values don't change until we revolt, but the loop below
+		may evaluate each option several times. Evaluate each civic only once. */
+	CivicValueMap aiCivicValue;
 	EnumMap<CivicOptionTypes,int> aiCurrentValue; // advc.enum
 	FOR_EACH_ENUM(CivicOption)
 	{
 		aiCurrentValue.set(eLoopCivicOption,
-				AI_civicValue(aeBestCivic.get(eLoopCivicOption)));
+				AI_civicValue(aeBestCivic.get(eLoopCivicOption), aiCivicValue));
 	}
 
 	int iAnarchyLength = 0;
@@ -19119,7 +19642,8 @@ void CvPlayerAI::AI_doCivics()
 		FOR_EACH_ENUM(CivicOption)
 		{
 			int iBestValue=-1;
-			CivicTypes const eNewCivic = AI_bestCivic(eLoopCivicOption, &iBestValue);
+			CivicTypes const eNewCivic = AI_bestCivic(eLoopCivicOption, &iBestValue,
+					aiCivicValue); // advc.opt
 			/*  advc.001r: Same thing as under karadoc's "temporary switch" comment
 				in the loop below */
 			CivicTypes eOtherCivic = aeBestCivic.get(eLoopCivicOption);
@@ -19188,7 +19712,7 @@ void CvPlayerAI::AI_doCivics()
 					{
 						/*	if the anarchy length would be the same,
 							consider waiting for the new civic. */
-						int iValue = AI_civicValue(eCivic);
+						int iValue = AI_civicValue(eCivic, aiCivicValue); // advc.opt
 						if (100 * iValue >
 							(102 + 2 * iResearchTurns) *
 							aiCurrentValue.get(kCivic.getCivicOptionType()) &&
@@ -19521,6 +20045,9 @@ void CvPlayerAI::AI_doDiplo()
 
 	if (GC.getPythonCaller()->AI_doDiplo(getID()))
 		return;
+	// <advc.opt> Fresh trade values for each player's diplomacy
+	AI_invalidateTradeValCache();
+	m_bTradeValCacheActive = true; // </advc.opt>
 
 	CvGame& kGame = GC.getGame();
 	CvTeamAI const& kOurTeam = GET_TEAM(getTeam());
@@ -20355,6 +20882,7 @@ void CvPlayerAI::AI_doDiplo()
 			}
 		}
 	}
+	m_bTradeValCacheActive = false; // advc.opt
 }
 
 // advc: This functions and the next few contain code cut from AI_doDiplo
@@ -26985,6 +27513,7 @@ int CvPlayerAI::AI_calculateTotalBombard(DomainTypes eDomain) const
 void CvPlayerAI::AI_updateBonusValue(BonusTypes eBonus)
 {
 	FAssertEnumBounds(eBonus); // advc
+	AI_invalidateTradeValCache(); // advc.opt
 	m_aiBonusValue[eBonus] = -1;
 	m_aiBonusValueTrade[eBonus] = -1;
 	/*  <advc.036> Don't just reset; recompute them all, and never update the
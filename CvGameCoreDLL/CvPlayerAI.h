@@ -12,6 +12,7 @@ class CvCityAI;
 class CvUnitAI;
 class CvSelectionGroupAI;
 class UWAICity; // advc.104d
+class CitySiteEvaluator; // advc.opt
 
 /*	<advc.003u> Overwrite definition in CvPlayer.h (should perhaps instead define a
 	new macro "PLAYERAI" - a lot of call locations to change though ...) */
@@ -90,6 +91,9 @@ public:
 
 	int AI_movementPriority(CvSelectionGroupAI const& kGroup) const;
 	void AI_unitUpdate();
+	/*	advc.opt: To be called when the outcome of AI_movementPriority may
+		change for the group with id iGroupID, or when it's added or deleted. */
+	void AI_setMovementPriorityDirty(int iGroupID);
 
 	void AI_makeAssignWorkDirty();
 	void AI_assignWorkingPlots();
@@ -151,6 +155,57 @@ public:
 	inline bool AI_isAnyWaterDanger(CvPlot const& kPlot, int iRange = DANGER_RANGE) const
 	{
 		return (AI_getWaterDanger(kPlot, iRange, 1) >= 1);
+	}
+	/*	Unit danger counts at DANGER_RANGE are cached per player and plot.
+		To be called upon any change that can affect them throughout the map:
+		plot ownership, terrain, features, improvements and routes, war and
+		peace, territory access, techs. */
+	static inline void AI_invalidateDangerCache()
+	{
+		m_iDangerCacheEpoch++;
+	}
+	/*	Invalidates only the counts within DANGER_RANGE of kPlot. For changes
+		of the units at kPlot (arrival, departure, status) and of the
+		visibility of kPlot. */
+	static void AI_invalidateDangerCache(CvPlot const& kPlot);
+	/*	Changes upon every invalidation of the danger cache, map-wide or local,
+		i.e. also when units move, die or get loaded and when visibility changes.
+		For caches that depend on all of that (GroupPathCache). */
+	static inline int AI_getDangerCacheEpoch()
+	{
+		return m_iDangerCacheEpoch + m_iDangerStamp;
+	}
+	/*	Best defenders (CvPlot::getBestDefender) and the defensive strength of
+		the units on a plot are cached too. They also depend on unit damage,
+		fortification and city defenses, which don't affect the danger counts.
+		The start of each group update invalidates them as well, and so do unit
+		moves and visibility changes (which the danger cache handles locally). */
+	static inline void AI_invalidateCombatCache()
+	{
+		m_iCombatCacheEpoch++;
+	}
+	// Changes whenever the danger cache or the combat cache gets invalidated
+	static inline int AI_getCombatCacheEpoch()
+	{
+		return m_iDangerCacheEpoch + m_iCombatCacheEpoch;
+	}
+	/*	Resource trade values (AI_bonusTradeVal) and tech trade values
+		(CvTeamAI::AI_techTradeVal) are memoized per pair of parties while
+		AI_doDiplo runs. Only then - other callers, e.g. the trade screen, are
+		asynchronous and mustn't fill a cache that synchronized code reads.
+		To be called upon any change that can affect those values during
+		diplomacy: techs, resource counts, war and peace, deals. */
+	static inline void AI_invalidateTradeValCache()
+	{
+		m_iTradeValCacheEpoch++;
+	}
+	static inline bool AI_isTradeValCacheActive()
+	{
+		return m_bTradeValCacheActive;
+	}
+	static inline int AI_getTradeValCacheEpoch()
+	{
+		return m_iTradeValCacheEpoch;
 	} // </advc.opt>
 
 	bool AI_avoidScience() const;
@@ -427,6 +482,13 @@ public:
 
 	CivicTypes AI_bestCivic(CivicOptionTypes eCivicOption, int* iBestValue = 0) const;
 	int AI_civicValue(CivicTypes eCivic) const;						// Exposed to Python
+	/*	<advc.opt> For decisions that look at the same civics repeatedly while the
+		civic values can't change. MIN_INT marks values not yet computed. */
+	typedef EnumMapDefault<CivicTypes,int,MIN_INT> CivicValueMap;
+	CivicTypes AI_bestCivic(CivicOptionTypes eCivicOption, int* piBestValue,
+			CivicValueMap& kCache) const;
+	int AI_civicValue(CivicTypes eCivic, CivicValueMap& kCache) const;
+	// </advc.opt>
 
 	ReligionTypes AI_bestReligion() const;
 	int AI_religionValue(ReligionTypes eReligion) const;
@@ -699,6 +761,22 @@ public:
 	void write(FDataStreamBase* pStream);
 
 protected:
+	// <advc.opt>
+	enum DangerCacheSlot
+	{
+		DANGER_CACHE_TEST_MOVES,
+		DANGER_CACHE_NO_TEST_MOVES,
+		DANGER_CACHE_WATER,
+		NUM_DANGER_CACHE_SLOTS
+	};
+	struct DangerCacheEntry
+	{
+		int iEpoch;
+		int iStamp; // m_iDangerStamp when cached
+		short iCount;
+		bool bExact; // false if counting stopped at a limit
+	}; // </advc.opt>
+
 	int m_iPeaceWeight;
 	int m_iEspionageWeight;
 	int m_iAttackOddsChange;
@@ -777,9 +855,55 @@ protected:
 
 	bool m_bWasFinancialTrouble;
 	int m_iTurnLastProductionDirty;
+	// <advc.opt> Not serialized
+	mutable std::vector<DangerCacheEntry> m_aDangerCache;
+	static int m_iDangerCacheEpoch;
+	/*	Local invalidation: m_iDangerStamp counts the AI_invalidateDangerCache(CvPlot)
+		calls; m_aiDangerPlotStamps stores, per plot number, the value of the
+		last call that affected the plot. */
+	static int m_iDangerStamp;
+	static std::vector<int> m_aiDangerPlotStamps;
+	static int m_iCombatCacheEpoch;
+	static int m_iTradeValCacheEpoch;
+	static bool m_bTradeValCacheActive;
+	/*	AI_bonusTradeVal for iChange=1 and iChange=-1 by (eFromPlayer, eBonus);
+		MIN_INT if not cached. Valid while m_iBonusTradeValCacheEpoch equals
+		m_iTradeValCacheEpoch. */
+	mutable std::vector<int> m_aiBonusTradeValCache;
+	mutable int m_iBonusTradeValCacheEpoch;
+	int* AI_bonusTradeValCacheEntry(BonusTypes eBonus, PlayerTypes eFromPlayer,
+			int iChange) const;
+	/*	Defensive strength per plot as computed by AI_localDefenceStrength
+		when the defenders stay in place */
+	struct DefenceCacheEntry
+	{
+		int iEpoch;
+		int iStrength;
+		short iDefenders;
+		char eDefenceTeam;
+		char eDomain;
+	};
+	mutable std::vector<DefenceCacheEntry> m_aDefenceCache;
+	/*	Found values before the adjustments made by AI_updateCitySites;
+		-1 if not cached. */
+	std::vector<short> m_aiBaseFoundValue;
+	std::vector<int> m_aiFoundValueInputs; // see AI_getFoundValueInputs
+	std::vector<int> m_aiFoundValueBonusInputs; // see AI_getFoundValueBonusInputs
+	int m_iFoundValueStamp;
+	/*	Groups ordered by (AI_movementPriority, id) for AI_unitUpdate.
+		Groups marked as dirty get re-keyed before the next pass;
+		entirely rebuilt once per game turn. */
+	std::set<std::pair<int,int> > m_movementPriorityQueue;
+	std::map<int,int> m_movementPriorityKeys; // group id -> priority in queue
+	std::vector<int> m_aiMovementPriorityDirty; // group ids
+	int m_iMovementPriorityTurn; // -1 means that the queue needs to be rebuilt
+	int m_iMovementPriorityBestCombat; // GC.getGame().getBestLandUnitCombat()
+	bool m_bMovementPriorityCities; // getNumCities() > 0
+	// </advc.opt>
 
 	void AI_doCounter();
 	void AI_doMilitary();
+	void AI_updateMovementPriorityQueue(); // advc.opt
 	void AI_doResearch();
 	void AI_doCivics();
 	void AI_doReligion();
@@ -883,6 +1007,17 @@ protected:
 	int AI_countDangerousUnits(CvPlot const& kAttackerPlot, CvPlot const& kDefenderPlot,
 			bool bTestMoves, int iLimit = MAX_INT,
 			PlayerTypes eAttackPlayer = NO_PLAYER) const; // </advc>
+	// <advc.opt>
+	int AI_countPlotDangerUnits(CvPlot const& kPlot, int iRange, bool bTestMoves,
+			int iLimit, PlayerTypes eAttackPlayer) const;
+	int AI_countWaterDangerUnits(CvPlot const& kPlot, int iRange, int iLimit) const;
+	int AI_cachedDangerCount(CvPlot const& kPlot, DangerCacheSlot eSlot,
+			int iLimit) const;
+	void AI_cacheDangerCount(CvPlot const& kPlot, DangerCacheSlot eSlot,
+			int iCount, int iLimit) const;
+	void AI_getFoundValueInputs(CitySiteEvaluator const& kEval,
+			std::vector<int>& r) const;
+	void AI_getFoundValueBonusInputs(std::vector<int>& r) const; // </advc.opt>
 	// advc.130c:
 	int AI_knownRankDifference(PlayerTypes eOther, scaled& rOutrankingBothRatio) const;
 	// advc.042: Relies on caller to reset GC.getBorderFinder()
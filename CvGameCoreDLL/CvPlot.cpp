@@ -8,6 +8,7 @@
 #include "CvArea.h"
 #include "CvUnit.h"
 #include "CvSelectionGroup.h"
+#include "CvGameTextMgr.h" // advc.opt
 #include "CvInfo_City.h"
 #include "CvInfo_Terrain.h"
 #include "CvInfo_GameOption.h"
@@ -25,6 +26,8 @@
 
 bool CvPlot::m_bAllFog = false; // advc.706
 int CvPlot::m_iMaxVisibilityRangeCache = -1; // advc.003h
+PlotVisibility* CvPlot::m_pVisibility = NULL; // advc.opt
+std::vector<CvPlot::BestDefenderCacheEntry> CvPlot::m_aBestDefenderCache; // advc.opt
 #define NO_BUILD_IN_PROGRESS (-2) // advc.011
 
 
@@ -1378,6 +1381,58 @@ int CvPlot::seeThroughLevel() const
 }
 
 
+namespace
+{
+	// advc.opt: Displacement to be checked by changeAdjacentSight
+	struct SightOffset
+	{
+		int iDX, iDY;
+		bool bOuterRing;
+	};
+	/*	advc.opt: The displacements that changeAdjacentSight checks for a
+		given range (incl. the extra outer ring) and facing direction - i.e.
+		the ones that pass shouldProcessDisplacementPlot. Computed once. */
+	std::vector<SightOffset> const& getSightOffsets(int iRange,
+		DirectionTypes eFacingDirection)
+	{
+		/*	(Map nodes don't move when other entries get inserted, so the
+			returned references stay valid.) */
+		static std::map<int,std::vector<SightOffset> > cache;
+		int const iKey = iRange * (NUM_DIRECTION_TYPES + 1) + eFacingDirection + 1;
+		std::map<int,std::vector<SightOffset> >::iterator pos = cache.find(iKey);
+		if (pos != cache.end())
+			return pos->second;
+		std::vector<SightOffset>& kOffsets = cache[iKey];
+		for (int iDX = -iRange; iDX <= iRange; iDX++)
+		{
+			for (int iDY = -iRange; iDY <= iRange; iDY++)
+			{
+				if (!CvPlot::shouldProcessDisplacementPlot(iDX, iDY, eFacingDirection))
+					continue;
+				SightOffset offset;
+				offset.iDX = iDX;
+				offset.iDY = iDY;
+				offset.bOuterRing = (abs(iDX) == iRange || abs(iDY) == iRange);
+				kOffsets.push_back(offset);
+			}
+		}
+		return kOffsets;
+	}
+}
+
+// advc.opt: Cut from changeAdjacentSight
+void CvPlot::getSeeInvisibleTypes(CvUnit const* pUnit, std::vector<InvisibleTypes>& r)
+{
+	if (pUnit != NULL)
+	{
+		for(int i = 0; i < pUnit->getNumSeeInvisibleTypes(); i++)
+			r.push_back(pUnit->getSeeInvisibleType(i));
+	}
+	if(r.empty())
+		r.push_back(NO_INVISIBLE);
+}
+
+
 void CvPlot::changeAdjacentSight(TeamTypes eTeam, int iRange, bool bIncrement,
 	CvUnit const* pUnit, bool bUpdatePlotGroups) // advc: const CvUnit*
 {
@@ -1391,60 +1446,50 @@ void CvPlot::changeAdjacentSight(TeamTypes eTeam, int iRange, bool bIncrement,
 
 	// fill invisible types
 	std::vector<InvisibleTypes> aeSeeInvisibleTypes;
-	if (pUnit != NULL)
-	{
-		for(int i = 0; i < pUnit->getNumSeeInvisibleTypes(); i++)
-			aeSeeInvisibleTypes.push_back(pUnit->getSeeInvisibleType(i));
-	}
-	if(aeSeeInvisibleTypes.empty())
-		aeSeeInvisibleTypes.push_back(NO_INVISIBLE);
+	getSeeInvisibleTypes(pUnit, aeSeeInvisibleTypes); // advc.opt
 
 	// check one extra outer ring
 	if (!bAerial)
 		iRange++;
+	// advc.opt: Precomputed shouldProcessDisplacementPlot checks
+	std::vector<SightOffset> const& kOffsets = getSightOffsets(iRange,
+			bAerial ? NO_DIRECTION : eFacingDirection);
 
 	for(size_t i = 0; i < aeSeeInvisibleTypes.size(); i++)
 	{
-		for (int iDX = -iRange; iDX <= iRange; iDX++)
+		for (size_t j = 0; j < kOffsets.size(); j++)
 		{
-			for (int iDY = -iRange; iDY <= iRange; iDY++)
+			int const iDX = kOffsets[j].iDX;
+			int const iDY = kOffsets[j].iDY;
+			// check if anything blocking the plot
+			if (bAerial ||
+				canSeeDisplacementPlot(eTeam, iDX, iDY, iDX, iDY, true,
+				kOffsets[j].bOuterRing))
 			{
-				// check if in facing direction
-				if (bAerial ||
-					shouldProcessDisplacementPlot(iDX, iDY, /*iRange - 1,*/ eFacingDirection))
+				CvPlot* pPlot = plotXY(getX(), getY(), iDX, iDY);
+				if (pPlot != NULL)
 				{
-					bool outerRing = false;
-					if (abs(iDX) == iRange || abs(iDY) == iRange)
-						outerRing = true;
-
-					// check if anything blocking the plot
-					if (bAerial ||
-						canSeeDisplacementPlot(eTeam, iDX, iDY, iDX, iDY, true, outerRing))
-					{
-						CvPlot* pPlot = plotXY(getX(), getY(), iDX, iDY);
-						if (pPlot != NULL)
-						{
-							pPlot->changeVisibilityCount(eTeam, bIncrement ? 1 : -1,
-									aeSeeInvisibleTypes[i], bUpdatePlotGroups,
-									pUnit); // advc.071
-						}
-					}
+					pPlot->changeVisibilityCount(eTeam, bIncrement ? 1 : -1,
+							aeSeeInvisibleTypes[i], bUpdatePlotGroups,
+							pUnit); // advc.071
 				}
-
-				if (eFacingDirection != NO_DIRECTION)
-				{	// always reveal adjacent plots when using line of sight
-					if(abs(iDX) <= 1 && abs(iDY) <= 1)
+			}
+		}
+		if (eFacingDirection != NO_DIRECTION)
+		{	// always reveal adjacent plots when using line of sight
+			for (int iDX = -1; iDX <= 1; iDX++)
+			{
+				for (int iDY = -1; iDY <= 1; iDY++)
+				{
+					CvPlot* pPlot = plotXY(getX(), getY(), iDX, iDY);
+					if (NULL != pPlot)
 					{
-						CvPlot* pPlot = plotXY(getX(), getY(), iDX, iDY);
-						if (NULL != pPlot)
-						{
-							pPlot->changeVisibilityCount(
-									eTeam, 1, aeSeeInvisibleTypes[i], bUpdatePlotGroups,
-									pUnit); // advc.071
-							pPlot->changeVisibilityCount(
-									eTeam, -1, aeSeeInvisibleTypes[i], bUpdatePlotGroups,
-									pUnit); // advc.071
-						}
+						pPlot->changeVisibilityCount(
+								eTeam, 1, aeSeeInvisibleTypes[i], bUpdatePlotGroups,
+								pUnit); // advc.071
+						pPlot->changeVisibilityCount(
+								eTeam, -1, aeSeeInvisibleTypes[i], bUpdatePlotGroups,
+								pUnit); // advc.071
 					}
 				}
 			}
@@ -1452,6 +1497,77 @@ void CvPlot::changeAdjacentSight(TeamTypes eTeam, int iRange, bool bIncrement,
 	}
 }
 
+/*	advc.opt: Only applies the net changes, so plots that the unit sees both
+	before and after the move aren't touched at all. (changeAdjacentSight
+	would make the count drop and rise again, which can trigger revealed-state,
+	plot group and fog updates twice per plot.) Not for line-of-sight units;
+	the caller needs to use changeAdjacentSight for those. */
+void CvPlot::moveAdjacentSight(CvPlot const& kFrom, CvPlot const& kTo,
+	TeamTypes eTeam, int iRange, CvUnit const& kUnit, bool bUpdatePlotGroups)
+{
+	PROFILE_FUNC();
+	FAssert(kUnit.getFacingDirection(true) == NO_DIRECTION);
+	std::vector<SightChange> aChanges;
+	kFrom.addAdjacentSight(eTeam, iRange, kUnit, -1, aChanges);
+	kTo.addAdjacentSight(eTeam, iRange, kUnit, 1, aChanges);
+	std::sort(aChanges.begin(), aChanges.end());
+	// Merge changes of the same plot and invisible type
+	size_t iMerged = 0;
+	for (size_t i = 0; i < aChanges.size(); i++)
+	{
+		if (iMerged > 0 && !(aChanges[iMerged - 1] < aChanges[i]))
+			aChanges[iMerged - 1].iChange += aChanges[i].iChange;
+		else aChanges[iMerged++] = aChanges[i];
+	}
+	aChanges.resize(iMerged);
+	// Decrease first, like a decrement at kFrom followed by an increment at kTo.
+	for (int iPass = 0; iPass < 2; iPass++)
+	{
+		for (size_t i = 0; i < aChanges.size(); i++)
+		{
+			SightChange const& kChange = aChanges[i];
+			if (iPass == 0 ? kChange.iChange >= 0 : kChange.iChange <= 0)
+				continue;
+			kChange.pPlot->changeVisibilityCount(eTeam, kChange.iChange,
+					kChange.eInvisible, bUpdatePlotGroups, &kUnit);
+		}
+	}
+}
+
+/*	advc.opt: Records the changes that changeAdjacentSight would make
+	(w/o line of sight) instead of applying them */
+void CvPlot::addAdjacentSight(TeamTypes eTeam, int iRange, CvUnit const& kUnit,
+	int iChange, std::vector<SightChange>& kChanges) const
+{
+	bool const bAerial = (kUnit.getDomainType() == DOMAIN_AIR);
+	std::vector<InvisibleTypes> aeSeeInvisibleTypes;
+	getSeeInvisibleTypes(&kUnit, aeSeeInvisibleTypes);
+	if (!bAerial)
+		iRange++;
+	std::vector<SightOffset> const& kOffsets = getSightOffsets(iRange, NO_DIRECTION);
+	for (size_t j = 0; j < kOffsets.size(); j++)
+	{
+		int const iDX = kOffsets[j].iDX;
+		int const iDY = kOffsets[j].iDY;
+		if (!bAerial &&
+			!canSeeDisplacementPlot(eTeam, iDX, iDY, iDX, iDY, true,
+			kOffsets[j].bOuterRing))
+		{
+			continue;
+		}
+		CvPlot* pPlot = plotXY(getX(), getY(), iDX, iDY);
+		if (pPlot == NULL)
+			continue;
+		for (size_t i = 0; i < aeSeeInvisibleTypes.size(); i++)
+		{
+			SightChange change;
+			change.pPlot = pPlot;
+			change.eInvisible = aeSeeInvisibleTypes[i];
+			change.iChange = iChange;
+			kChanges.push_back(change);
+		}
+	}
+}
 
 bool CvPlot::canSeePlot(CvPlot const* pPlot, TeamTypes eTeam, int iRange,
 	DirectionTypes eFacingDirection) const
@@ -1580,7 +1696,7 @@ bool CvPlot::canSeeDisplacementPlot(TeamTypes eTeam, int iDX, int iDY,
 
 
 bool CvPlot::shouldProcessDisplacementPlot(int iDX, int iDY, //int iRange, // advc: unused
-	DirectionTypes eFacingDirection) const
+	DirectionTypes eFacingDirection) // advc.opt: static
 {
 	if (eFacingDirection == NO_DIRECTION)
 		return true;
@@ -2172,6 +2288,46 @@ CvUnit* CvPlot::getBestDefender(PlayerTypes eOwner, PlayerTypes eAttackingPlayer
 	}
 	// isEnemy implies isPotentialEnemy
 	FAssert(!bTestEnemy || !bTestPotentialEnemy); // </advc>
+	/*	<advc.opt> AI code tends to ask the same question for one plot many times,
+		e.g. once for each unit of an attacking stack. */
+	BestDefenderCacheEntry* pCacheEntry = NULL;
+	byte const uiFlags = (byte)((bTestEnemy ? 1 : 0) | (bTestPotentialEnemy ? 2 : 0) |
+			(bTestVisible ? 4 : 0) | (bTestCanAttack ? 8 : 0));
+	if (!bAny && m_units.getLength() > 1)
+	{
+		CvMap const& kMap = GC.getMap();
+		if ((int)m_aBestDefenderCache.size() != kMap.numPlots())
+		{
+			BestDefenderCacheEntry kInvalid;
+			kInvalid.iEpoch = -1;
+			kInvalid.eOwner = NO_PLAYER;
+			kInvalid.eAttackingPlayer = NO_PLAYER;
+			kInvalid.uiFlags = 0;
+			m_aBestDefenderCache.assign(kMap.numPlots(), kInvalid);
+		}
+		pCacheEntry = &m_aBestDefenderCache[kMap.plotNum(*this)];
+		if (pCacheEntry->iEpoch == CvPlayerAI::AI_getCombatCacheEpoch() &&
+			pCacheEntry->eOwner == eOwner &&
+			pCacheEntry->eAttackingPlayer == eAttackingPlayer &&
+			pCacheEntry->uiFlags == uiFlags)
+		{
+			bool bHit = false;
+			if (pAttacker == NULL)
+				bHit = (pCacheEntry->attacker.iID == FFreeList::INVALID_INDEX);
+			else if (pCacheEntry->attacker.iID != FFreeList::INVALID_INDEX)
+			{
+				CvUnit const* pCachedAttacker = ::getUnit(pCacheEntry->attacker);
+				bHit = (pCachedAttacker != NULL &&
+						pAttacker->isCombatEquivalent(*pCachedAttacker));
+			}
+			if (bHit)
+			{
+				if (pCacheEntry->defender.iID == FFreeList::INVALID_INDEX)
+					return NULL;
+				return ::getUnit(pCacheEntry->defender);
+			}
+		}
+	} // </advc.opt>
 	// BETTER_BTS_AI_MOD, Lead From Behind (UncutDragon), 02/21/10, jdog5000
 	int iBestUnitRank = -1;
 	CvUnit* pBestUnit = NULL;
@@ -2198,9 +2354,30 @@ CvUnit* CvPlot::getBestDefender(PlayerTypes eOwner, PlayerTypes eAttackingPlayer
 		}
 	}
 	// BETTER_BTS_AI_MOD: END
+	// <advc.opt>
+	if (pCacheEntry != NULL)
+	{
+		pCacheEntry->iEpoch = CvPlayerAI::AI_getCombatCacheEpoch();
+		pCacheEntry->eOwner = (char)eOwner;
+		pCacheEntry->eAttackingPlayer = (char)eAttackingPlayer;
+		pCacheEntry->uiFlags = uiFlags;
+		if (pAttacker == NULL)
+			pCacheEntry->attacker.reset();
+		else pCacheEntry->attacker = pAttacker->getIDInfo();
+		if (pBestUnit == NULL)
+			pCacheEntry->defender.reset();
+		else pCacheEntry->defender = pBestUnit->getIDInfo();
+	} // </advc.opt>
 	return pBestUnit;
 }
 
+// advc.opt: Needs to be called when the plots or units get replaced (e.g. upon loading a game)
+void CvPlot::resetBestDefenderCache()
+{
+	// Release the memory (clear wouldn't)
+	std::vector<BestDefenderCacheEntry>().swap(m_aBestDefenderCache);
+}
+
 
 CvUnit* CvPlot::getSelectedUnit() const
 {
@@ -3342,15 +3519,18 @@ void CvPlot::setArea(CvArea* pArea, /* advc.310: */ bool bProcess)
 {
 	if (area() == pArea)
 		return;
+	CvCity::invalidateTradeProfits(); // advc.opt
 	// <advc.310>
 	if (!bProcess)
 	{
 		m_pArea = pArea;
+		GC.getMap().updatePlotFields(*this); // advc.opt
 		return;
 	} // </advc.310>
 	if (area() != NULL)
 		processArea(getArea(), -1);
 	m_pArea = pArea;
+	GC.getMap().updatePlotFields(*this); // advc.opt
 	// advc: Update cached CvArea pointers (even if pArea==NULL)
 	if (isCity())
 		getPlotCity()->updateArea();
@@ -3628,6 +3808,7 @@ void CvPlot::setIrrigated(bool bNewValue)
 	if(isIrrigated() == bNewValue)
 		return;
 	m_bIrrigated = bNewValue;
+	GC.getMap().setFoundValuesDirty(*this); // advc.opt
 	FOR_EACH_ADJ_PLOT_VAR(*this)
 	{
 		pAdj->updateYield();
@@ -3725,6 +3906,8 @@ bool CvPlot::isFlagDirty() const
 void CvPlot::setFlagDirty(bool bNewValue)
 {
 	m_bFlagDirty = bNewValue;
+	if (bNewValue) // advc.opt
+		CvGameTextMgr::invalidateHelpTextCache();
 }
 
 
@@ -3740,6 +3923,9 @@ void CvPlot::setOwner(PlayerTypes eNewValue, bool bCheckUnits, bool bUpdatePlotG
 
 	if(getOwner() == eNewValue)
 		return;
+	CvTeamAI::AI_invalidatePathCaches(*this); // advc.opt
+	CvPlayerAI::AI_invalidateDangerCache(); // advc.opt
+	GC.getMap().setFoundValuesDirty(*this); // advc.opt
 	PlayerTypes eOldOwner = getOwner(); // advc.ctr
 	GC.getGame().addReplayMessage(REPLAY_MESSAGE_PLOT_OWNER_CHANGE, eNewValue, (char*)NULL, getX(), getY());
 
@@ -3979,6 +4165,10 @@ void CvPlot::setPlotType(PlotTypes eNewValue, bool bRecalculate, bool bRebuildGr
 
 	bool const bWasWater = isWater();
 	bool const bWasImpassable = isImpassable(); // advc.030
+	// advc.opt: Areas and isthmuses may change
+	CvTeamAI::AI_invalidatePathCaches();
+	CvPlayerAI::AI_invalidateDangerCache(); // advc.opt
+	GC.getMap().setAllFoundValuesDirty(); // advc.opt
 
 	updateSeeFromSight(false, true);
 
@@ -4157,6 +4347,9 @@ void CvPlot::setTerrainType(TerrainTypes eNewValue, bool bRecalculate, bool bReb
 {
 	if(getTerrainType() == eNewValue)
 		return;
+	CvTeamAI::AI_invalidatePathCaches(*this); // advc.opt
+	CvPlayerAI::AI_invalidateDangerCache(); // advc.opt
+	GC.getMap().setFoundValuesDirty(*this); // advc.opt
 
 	bool bUpdateSight = (getTerrainType() != NO_TERRAIN && // advc
 			eNewValue != NO_TERRAIN &&
@@ -4210,6 +4403,12 @@ void CvPlot::setFeatureType(FeatureTypes eNewValue, int iVariety)
 	FeatureTypes eOldFeature = getFeatureType();
 	if(eOldFeature == eNewValue && m_iFeatureVariety == iVariety)
 		return; // advc
+	if (eOldFeature != eNewValue)
+	{	// <advc.opt>
+		CvTeamAI::AI_invalidatePathCaches(*this);
+		CvPlayerAI::AI_invalidateDangerCache();
+		GC.getMap().setFoundValuesDirty(*this); // </advc.opt>
+	}
 
 	bool bUpdateSight = false;
 
@@ -4352,6 +4551,8 @@ void CvPlot::setBonusType(BonusTypes eNewValue)
 {
 	if(getBonusType() == eNewValue)
 		return;
+	CvPlayerAI::AI_invalidateDangerCache(); // advc.opt
+	GC.getMap().setFoundValuesDirty(*this); // advc.opt
 
 	if (getBonusType() != NO_BONUS)
 	{
@@ -4364,6 +4565,7 @@ void CvPlot::setBonusType(BonusTypes eNewValue)
 
 	updatePlotGroupBonus(false, /* advc.064d: */ false);
 	m_eBonusType = eNewValue;
+	GC.getMap().updatePlotFields(*this); // advc.opt
 	updatePlotGroupBonus(true);
 
 	if (getBonusType() != NO_BONUS)
@@ -4386,6 +4588,9 @@ void CvPlot::setImprovementType(ImprovementTypes eNewValue,
 	ImprovementTypes const eOldImprovement = getImprovementType();
 	if(getImprovementType() == eNewValue)
 		return;
+	CvTeamAI::AI_invalidatePathCaches(*this); // advc.opt
+	CvPlayerAI::AI_invalidateDangerCache(); // advc.opt
+	GC.getMap().setFoundValuesDirty(*this); // advc.opt
 	// <advc.183>
 	bool const bActedAsCity = (eOldImprovement != NO_IMPROVEMENT &&
 			GC.getInfo(eOldImprovement).isActsAsCity()); // </advc.183>
@@ -4495,6 +4700,9 @@ void CvPlot::setRouteType(RouteTypes eNewValue, bool bUpdatePlotGroups)
 {
 	if(getRouteType() == eNewValue)
 		return;
+	CvTeamAI::AI_invalidatePathCaches(*this); // advc.opt
+	CvPlayerAI::AI_invalidateDangerCache(); // advc.opt
+	GC.getMap().setFoundValuesDirty(*this); // advc.opt
 
 	bool const bOldRoute = isRoute(); // XXX is this right???
 
@@ -4566,6 +4774,9 @@ void CvPlot::setPlotCity(CvCity* pNewValue)
 {
 	if(getPlotCity() == pNewValue)
 		return;
+	CvTeamAI::AI_invalidatePathCaches(*this); // advc.opt (cities act as canals)
+	CvPlayerAI::AI_invalidateDangerCache(); // advc.opt
+	GC.getMap().setFoundValuesDirty(*this, true); // advc.opt
 
 	if (isCity())
 	{
@@ -4679,6 +4890,7 @@ void CvPlot::updateWorkingCity()
 	CvCity* pOldWorkingCity = getWorkingCity();
 	if (pOldWorkingCity == pBestCity)
 		return;
+	GC.getMap().setFoundValuesDirty(*this); // advc.opt
 
 	if (pOldWorkingCity != NULL)
 		pOldWorkingCity->setWorkingPlot(*this, false);
@@ -5110,6 +5322,8 @@ void CvPlot::updateYield()
 		bChange = true;
 	}
 
+	/*	(advc.opt: City site evaluation uses calculateNatureYield, whose inputs
+		mark the found values dirty in their own setters.) */
 	if (bChange)
 		updateSymbols();
 }
@@ -5130,6 +5344,7 @@ int CvPlot::countTotalCulture() const
 void CvPlot::updateTeam() // advc.opt: What getTeam used to do
 {
 	m_eTeam = (isOwned() ? TEAMID(getOwner()) : NO_TEAM);
+	GC.getMap().updatePlotFields(*this); // advc.opt
 }
 
 
@@ -5201,6 +5416,7 @@ void CvPlot::setCulture(PlayerTypes eIndex, int iNewValue, bool bUpdate,
 
 	if(getCulture(eIndex) == iNewValue)
 		return;
+	int const iOldValue = getCulture(eIndex); // advc.opt
 	 // <advc.opt>
 	if(GET_PLAYER(eIndex).isEverAlive())
 		m_iTotalCulture += iNewValue - m_aiCulture.get(eIndex); // </advc.opt>
@@ -5213,6 +5429,16 @@ void CvPlot::setCulture(PlayerTypes eIndex, int iNewValue, bool bUpdate,
 	CvCity* pCity = getPlotCity();
 	if(pCity != NULL)
 		pCity->AI_setAssignWorkDirty(true);
+	/*	<advc.opt> City site evaluation only compares the tile culture of owned
+		plots and of plots in a city radius, and only within the site's radius.
+		Tile culture grows every turn; mark the sites only when the highest set
+		bit of the value changes, i.e. when culture crosses a power of 2. (For
+		a < b, the highest bits differ iff a^b > a.) */
+	if ((isOwned() || isCityRadius()) &&
+		(iOldValue ^ iNewValue) > std::min(iOldValue, iNewValue))
+	{
+		GC.getMap().setCityRadiusFoundValuesDirty(*this);
+	} // </advc.opt>
 }
 
 
@@ -5362,6 +5588,7 @@ void CvPlot::setPlotGroup(PlayerTypes ePlayer, CvPlotGroup* pNewValue,
 	CvPlotGroup* pOldPlotGroup = getPlotGroup(ePlayer);
 	if (pOldPlotGroup == pNewValue)
 		return;
+	CvCity::invalidateTradeProfits(); // advc.opt (connection to capital)
 
 	CvCity* pCity = getPlotCity();
 	if (ePlayer == getOwner())
@@ -5390,6 +5617,15 @@ void CvPlot::setPlotGroup(PlayerTypes ePlayer, CvPlotGroup* pNewValue,
 		updatePlotGroupBonus(true, /* advc.064d: */ bVerifyProduction);
 }
 
+// advc.opt:
+void CvPlot::setPlotGroupNoBonusUpdate(PlayerTypes ePlayer, CvPlotGroup* pNewValue)
+{
+	CvCity::invalidateTradeProfits(); // (connection to capital)
+	if (pNewValue == NULL)
+		m_aiPlotGroup.set(ePlayer, FFreeList::INVALID_INDEX);
+	else m_aiPlotGroup.set(ePlayer, pNewValue->getID());
+}
+
 
 void CvPlot::updatePlotGroup(/* advc.064d: */ bool bVerifyProduction)
 {
@@ -5441,7 +5677,10 @@ void CvPlot::updatePlotGroup(PlayerTypes ePlayer, bool bRecalculate,
 
 				pPlotGroup->removePlot(this, /* advc.064d: */ bVerifyProduction);
 				if (!bEmpty)
-					pPlotGroup->recalculatePlots(/* advc.064d: */ bVerifyProduction);
+				{	// advc.opt: was recalculatePlots
+					pPlotGroup->recalculatePlotsAfterRemoval(*this,
+							/* advc.064d: */ bVerifyProduction);
+				}
 			}
 		}
 		pPlotGroup = getPlotGroup(ePlayer);
@@ -5487,7 +5726,9 @@ void CvPlot::changeVisibilityCount(TeamTypes eTeam, int iChange,
 
 	bool const bOldVisible = isVisible(eTeam);
 
-	m_aiVisibilityCount.add(eTeam, iChange);
+	// advc.opt: was m_aiVisibilityCount.add(eTeam, iChange)
+	m_pVisibility->setVisibilityCount(eTeam, visibilityIndex(),
+			getVisibilityCount(eTeam) + iChange);
 	//FAssert(getVisibilityCount(eTeam) >= 0);
 	/*  <advc.006> Had some problems here with the Earth1000AD scenario as the
 		initial cities were being placed and over the first few turns.
@@ -5498,8 +5739,8 @@ void CvPlot::changeVisibilityCount(TeamTypes eTeam, int iChange,
 		or Jungle. */
 	if(getVisibilityCount(eTeam) < 0)
 	{
-		FAssert(m_aiVisibilityCount.get(eTeam) >= 0);
-		m_aiVisibilityCount.set(eTeam, 0);
+		FAssert(getVisibilityCount(eTeam) >= 0);
+		m_pVisibility->setVisibilityCount(eTeam, visibilityIndex(), 0); // advc.opt
 	} // </advc.006>
 
 	if (eSeeInvisible != NO_INVISIBLE)
@@ -5507,6 +5748,9 @@ void CvPlot::changeVisibilityCount(TeamTypes eTeam, int iChange,
 
 	if (bOldVisible == isVisible(eTeam))
 		return;
+	// <advc.opt>
+	CvPlayerAI::AI_invalidateDangerCache(*this);
+	CvPlayerAI::AI_invalidateCombatCache(); // (visible best defenders) </advc.opt>
 
 	if (isVisible(eTeam))
 	{
@@ -5569,7 +5813,9 @@ void CvPlot::changeStolenVisibilityCount(TeamTypes eTeam, int iChange)
 
 	bool bOldVisible = isVisible(eTeam);
 
-	m_aiStolenVisibilityCount.add(eTeam, iChange);
+	// advc.opt: was m_aiStolenVisibilityCount.add(eTeam, iChange)
+	m_pVisibility->setStolenVisibilityCount(eTeam, visibilityIndex(),
+			getStolenVisibilityCount(eTeam) + iChange);
 	FAssert(getStolenVisibilityCount(eTeam) >= 0);
 
 	if (bOldVisible != isVisible(eTeam))
@@ -5636,6 +5882,7 @@ void CvPlot::setRevealedOwner(TeamTypes eTeam, PlayerTypes eNewValue)
 		return;
 
 	m_aiRevealedOwner.set(eTeam, eNewValue);
+	GC.getMap().setFoundValuesDirty(*this); // advc.opt
 	// K-Mod
 	if (eNewValue != NO_PLAYER)
 	{
@@ -5804,8 +6051,10 @@ void CvPlot::setRevealed(TeamTypes eTeam, bool bNewValue, bool bTerrainOnly, Tea
 	bool bOldValue = isRevealed(eTeam); // advc.124
 	if (bOldValue != bNewValue)
 	{
-		m_abRevealed.set(eTeam, bNewValue);
+		m_pVisibility->setRevealed(eTeam, visibilityIndex(), bNewValue); // advc.opt
 		getArea().changeNumRevealedTiles(eTeam, isRevealed(eTeam) ? 1 : -1);
+		GC.getMap().setFoundValuesDirty(*this); // advc.opt
+		CvSelectionGroup::invalidateSharedPaths(); // advc.opt
 	}  // <advc.124> Need to update plot group if any revealed info changes
 	if (bUpdatePlotGroup &&
 		(bOldValue != bNewValue ||
@@ -5924,6 +6173,7 @@ void CvPlot::setRevealedImprovementType(TeamTypes eTeam, ImprovementTypes eNewVa
 		return;
 
 	m_aeRevealedImprovementType.set(eTeam, eNewValue);
+	GC.getMap().setFoundValuesDirty(*this); // advc.opt
 
 	if (eTeam == GC.getGame().getActiveTeam())
 	{
@@ -5951,6 +6201,8 @@ void CvPlot::setRevealedRouteType(TeamTypes eTeam, RouteTypes eNewValue)
 		return;
 
 	m_aeRevealedRouteType.set(eTeam, eNewValue);
+	GC.getMap().setFoundValuesDirty(*this); // advc.opt
+	CvSelectionGroup::invalidateSharedPaths(); // advc.opt
 
 	if (eTeam == GC.getGame().getActiveTeam())
 	{
@@ -6392,7 +6644,10 @@ void CvPlot::changeCultureRangeCities(PlayerTypes eOwnerIndex, CultureLevelTypes
 	m_aaiCultureRangeCities.add(eOwnerIndex, eRangeIndex, iChange);
 	FAssert(m_aaiCultureRangeCities.get(eOwnerIndex, eRangeIndex) >= 0); // advc
 	if (bOldCultureRangeCities != isCultureRangeCity(eOwnerIndex, eRangeIndex))
+	{
 		updateCulture(true, bUpdatePlotGroups);
+		GC.getMap().setFoundValuesDirty(*this); // advc.opt
+	}
 }
 
 
@@ -6406,6 +6661,9 @@ void CvPlot::changeInvisibleVisibilityCount(TeamTypes eTeam, InvisibleTypes eInv
 	FAssert(m_aaiInvisibleVisibilityCount.get(eTeam, eInvisible) >= 0); // advc
 	if (bOldInvisibleVisible != isInvisibleVisible(eTeam, eInvisible))
 	{
+		// <advc.opt>
+		CvPlayerAI::AI_invalidateDangerCache(*this);
+		CvPlayerAI::AI_invalidateCombatCache(); // </advc.opt>
 		if (eTeam == GC.getGame().getActiveTeam())
 			updateCenterUnit();
 	}
@@ -7018,12 +7276,29 @@ void CvPlot::read(FDataStreamBase* pStream)
 	pStream->Read(&cCount);
 	if (cCount > 0)
 		m_aiPlotGroup.Read(pStream);
+	// <advc.opt> Stored at CvMap now (through m_pVisibility)
 	pStream->Read(&cCount);
 	if (cCount > 0)
-		m_aiVisibilityCount.Read(pStream, false);
+	{
+		EnumMap<TeamTypes,short> aiVisibilityCount;
+		aiVisibilityCount.Read(pStream, false);
+		for (int i = 0; i < MAX_TEAMS; i++)
+		{
+			m_pVisibility->setVisibilityCount((TeamTypes)i, visibilityIndex(),
+					aiVisibilityCount.get((TeamTypes)i));
+		}
+	}
 	pStream->Read(&cCount);
 	if (cCount > 0)
-		m_aiStolenVisibilityCount.Read(pStream, false);
+	{
+		EnumMap<TeamTypes,short> aiStolenVisibilityCount;
+		aiStolenVisibilityCount.Read(pStream, false);
+		for (int i = 0; i < MAX_TEAMS; i++)
+		{
+			m_pVisibility->setStolenVisibilityCount((TeamTypes)i, visibilityIndex(),
+					aiStolenVisibilityCount.get((TeamTypes)i));
+		}
+	} // </advc.opt>
 	pStream->Read(&cCount);
 	if (cCount > 0)
 		m_aiBlockadedCount.Read(pStream, false);
@@ -7035,7 +7310,15 @@ void CvPlot::read(FDataStreamBase* pStream)
 		m_abRiverCrossing.Read(pStream);
 	pStream->Read(&cCount);
 	if (cCount > 0)
-		m_abRevealed.Read(pStream);
+	{	// advc.opt: Stored at CvMap now
+		EnumMap<TeamTypes,bool> abRevealed;
+		abRevealed.Read(pStream);
+		for (int i = 0; i < MAX_TEAMS; i++)
+		{
+			m_pVisibility->setRevealed((TeamTypes)i, visibilityIndex(),
+					abRevealed.get((TeamTypes)i));
+		}
+	}
 	pStream->Read(&cCount);
 	if (cCount > 0)
 		m_aeRevealedImprovementType.Read(pStream, false, uiFlag < 5);
@@ -7178,20 +7461,32 @@ void CvPlot::write(FDataStreamBase* pStream)
 		pStream->Write((char)m_aiPlotGroup.getLength());
 		m_aiPlotGroup.Write(pStream);
 	}
-	if (!m_aiVisibilityCount.hasContent())
+	/*	<advc.opt> Stored at CvMap now (through m_pVisibility). Write them
+		in the format of the EnumMaps that CvPlot used to have. */
+	EnumMap<TeamTypes,short> aiVisibilityCount;
+	EnumMap<TeamTypes,short> aiStolenVisibilityCount;
+	EnumMap<TeamTypes,bool> abRevealed;
+	for (int i = 0; i < MAX_TEAMS; i++)
+	{
+		TeamTypes const eTeam = (TeamTypes)i;
+		aiVisibilityCount.set(eTeam, toShort(getVisibilityCount(eTeam)));
+		aiStolenVisibilityCount.set(eTeam, toShort(getStolenVisibilityCount(eTeam)));
+		abRevealed.set(eTeam, isRevealed(eTeam));
+	}
+	if (!aiVisibilityCount.hasContent())
 		pStream->Write((char)0);
 	else
 	{
-		pStream->Write((char)m_aiVisibilityCount.getLength());
-		m_aiVisibilityCount.Write(pStream, false);
+		pStream->Write((char)aiVisibilityCount.getLength());
+		aiVisibilityCount.Write(pStream, false);
 	}
-	if (!m_aiStolenVisibilityCount.hasContent())
+	if (!aiStolenVisibilityCount.hasContent())
 		pStream->Write((char)0);
 	else
 	{
-		pStream->Write((char)m_aiStolenVisibilityCount.getLength());
-		m_aiStolenVisibilityCount.Write(pStream, false);
-	}
+		pStream->Write((char)aiStolenVisibilityCount.getLength());
+		aiStolenVisibilityCount.Write(pStream, false);
+	} // </advc.opt>
 	if (!m_aiBlockadedCount.hasContent())
 		pStream->Write((char)0);
 	else
@@ -7213,12 +7508,12 @@ void CvPlot::write(FDataStreamBase* pStream)
 		pStream->Write((char)m_abRiverCrossing.getLength());
 		m_abRiverCrossing.Write(pStream);
 	}
-	if (!m_abRevealed.hasContent())
+	if (!abRevealed.hasContent()) // advc.opt
 		pStream->Write((char)0);
 	else
 	{
-		pStream->Write((char)m_abRevealed.getLength());
-		m_abRevealed.Write(pStream);
+		pStream->Write((char)abRevealed.getLength());
+		abRevealed.Write(pStream);
 	}
 	if (!m_aeRevealedImprovementType.hasContent())
 		pStream->Write((char)0);
@@ -4,6 +4,7 @@
 #define CIV4_PLOT_H
 
 #include "PlotAdjListTraversal.h" // advc.003s
+#include "PlotVisibility.h" // advc.opt
 
 class CvArea;
 class CvMap;
@@ -106,12 +107,16 @@ public:
 	int seeThroughLevel() const;																	// Exposed to Python
 	void changeAdjacentSight(TeamTypes eTeam, int iRange, bool bIncrement,
 			CvUnit const* pUnit, bool bUpdatePlotGroups);
+	// advc.opt: Same as changeAdjacentSight at kFrom (decrement) and at kTo (increment)
+	static void moveAdjacentSight(CvPlot const& kFrom, CvPlot const& kTo,
+			TeamTypes eTeam, int iRange, CvUnit const& kUnit, bool bUpdatePlotGroups);
 	bool canSeePlot(CvPlot const* pPlot, TeamTypes eTeam, int iRange,
 			DirectionTypes eFacingDirection /* advc: */ = NO_DIRECTION) const;
 	bool canSeeDisplacementPlot(TeamTypes eTeam, int iDX, int iDY,
 			int iOriginalDX, int iOriginalDY, bool bFirstPlot, bool bOuterRing) const;
-	bool shouldProcessDisplacementPlot(int iDX, int iDY,// int range, // advc: unused
-			DirectionTypes eFacingDirection) const;
+	// advc.opt: static
+	static bool shouldProcessDisplacementPlot(int iDX, int iDY,// int range, // advc: unused
+			DirectionTypes eFacingDirection);
 	void updateSight(bool bIncrement, bool bUpdatePlotGroups);
 	void updateSeeFromSight(bool bIncrement, bool bUpdatePlotGroups);
 
@@ -231,6 +236,9 @@ public:
 	// <advc.706>
 	static bool isAllFog() { return m_bAllFog; }
 	static void setAllFog(bool b) { m_bAllFog = b; } // </advc.706>
+	// advc.opt: Owned by CvMap
+	static void setVisibilityStore(PlotVisibility* pVisibility) { m_pVisibility = pVisibility; }
+	static void resetBestDefenderCache(); // advc.opt
 	// <advc.300>
 	bool isCivUnitNearby(int iRadius) const;
 	CvPlot const* nearestInvisiblePlot(bool bOnlyLand, int iMaxPlotDist, TeamTypes eObserver) const;
@@ -565,6 +573,9 @@ public:
 	CvPlotGroup* getOwnerPlotGroup() const;
 	void setPlotGroup(PlayerTypes ePlayer, CvPlotGroup* pNewValue,
 			bool bVerifyProduction = true); // advc.064d
+	/*	advc.opt: For CvPlotGroup. Unlike setPlotGroup, leaves the bonus counts
+		of plot groups and cities to the caller. */
+	void setPlotGroupNoBonusUpdate(PlayerTypes ePlayer, CvPlotGroup* pNewValue);
 	void updatePlotGroup(/* advc.064d: */ bool bVerifyProduction = false);
 	void updatePlotGroup(PlayerTypes ePlayer, bool bRecalculate = true,
 			bool bVerifyProduction = true); // advc.064d
@@ -572,7 +583,7 @@ public:
 	// advc.inl
 	inline int getVisibilityCount(TeamTypes eTeam) const											// Exposed to Python
 	{
-		return m_aiVisibilityCount.get(eTeam);
+		return m_pVisibility->getVisibilityCount(eTeam, visibilityIndex()); // advc.opt
 	}
 	void changeVisibilityCount(TeamTypes eTeam, int iChange,										// Exposed to Python
 			InvisibleTypes eSeeInvisible, bool bUpdatePlotGroups,
@@ -580,7 +591,7 @@ public:
 	// advc.inl
 	inline int getStolenVisibilityCount(TeamTypes eTeam) const										// Exposed to Python
 	{
-		return m_aiStolenVisibilityCount.get(eTeam);
+		return m_pVisibility->getStolenVisibilityCount(eTeam, visibilityIndex()); // advc.opt
 	}
 	void changeStolenVisibilityCount(TeamTypes eTeam, int iChange);
 	// advc.inl
@@ -614,7 +625,7 @@ public:
 	// <advc.inl> Faster implementation for non-UI code
 	inline bool isRevealed(TeamTypes eTeam) const
 	{
-		return m_abRevealed.get(eTeam);
+		return m_pVisibility->isRevealed(eTeam, visibilityIndex()); // advc.opt
 	} // </advc.inl>
 	void setRevealed(TeamTypes eTeam, bool bNewValue, bool bTerrainOnly,							// Exposed to Python
 			TeamTypes eFromTeam, bool bUpdatePlotGroup);
@@ -865,13 +876,12 @@ protected:
 	EnumMapDefault<PlayerTypes,int,FFreeList::INVALID_INDEX> m_aiPlotGroup;
 	mutable EnumMap<PlayerTypes,short> m_aiFoundValue; // advc: mutable
 	EnumMap<PlayerTypes,char> m_aiPlayerCityRadiusCount;
-	EnumMap<TeamTypes,short> m_aiVisibilityCount;
-	EnumMap<TeamTypes,short> m_aiStolenVisibilityCount;
+	/*	advc.opt: Visibility counts and revealed flags moved to PlotVisibility
+		(m_pVisibility) */
 	EnumMap<TeamTypes,short> m_aiBlockadedCount;
 	EnumMap<TeamTypes,PlayerTypes> m_aiRevealedOwner;
 	EnumMap<TeamTypes,ImprovementTypes> m_aeRevealedImprovementType;
 	EnumMap<TeamTypes,RouteTypes> m_aeRevealedRouteType;
-	EnumMap<TeamTypes,bool> m_abRevealed;
 	EnumMap<DirectionTypes,bool> m_abRiverCrossing;
 	EnumMap<BuildTypes,short> m_aiBuildProgress;
 	EnumMap2D<PlayerTypes,CultureLevelTypes,char> m_aaiCultureRangeCities;
@@ -890,11 +900,46 @@ protected:
 
 	static bool m_bAllFog; // advc.706
 	static int m_iMaxVisibilityRangeCache; // advc.003h
+	static PlotVisibility* m_pVisibility; // advc.opt
+	/*	<advc.opt> Last result of getBestDefender for each plot (by plot number).
+		Valid while iEpoch equals CvPlayerAI::AI_getCombatCacheEpoch. The
+		attacker is just the unit that was passed; units with the same
+		CvUnit::isCombatEquivalent profile can use the result as well. */
+	struct BestDefenderCacheEntry
+	{
+		int iEpoch;
+		IDInfo defender; // iID is INVALID_INDEX if there was none
+		IDInfo attacker; // ditto if no attacker was passed
+		char eOwner;
+		char eAttackingPlayer;
+		byte uiFlags;
+	};
+	static std::vector<BestDefenderCacheEntry> m_aBestDefenderCache; // </advc.opt>
+
+	// advc.opt: Plot number as index into m_pVisibility
+	int visibilityIndex() const { return m_pVisibility->plotNum(getX(), getY()); }
 
 	void doFeature();
 	void doCulture();
 
 	int countTotalCulture() const; // advc.opt: Was public; replaced by getTotalCulture.
+	// <advc.opt> For moveAdjacentSight
+	struct SightChange
+	{
+		CvPlot* pPlot;
+		InvisibleTypes eInvisible;
+		int iChange;
+		bool operator<(SightChange const& kOther) const
+		{
+			if (pPlot != kOther.pPlot)
+				return (pPlot < kOther.pPlot);
+			return (eInvisible < kOther.eInvisible);
+		}
+	};
+	void addAdjacentSight(TeamTypes eTeam, int iRange, CvUnit const& kUnit,
+			int iChange, std::vector<SightChange>& kChanges) const;
+	static void getSeeInvisibleTypes(CvUnit const* pUnit,
+			std::vector<InvisibleTypes>& r); // </advc.opt>
 	int areaID() const;
 	void processArea(CvArea& kArea, int iChange);
 	char calculateLatitude() const; // advc.tsl
@@ -6,6 +6,36 @@
 
 int CvPlotGroup::m_iRecalculating = 0; // advc.064d
 
+namespace
+{
+	/*	advc.opt: Search label of each plot (by plot number) for
+		recalculatePlotsAfterRemoval. Only valid where the stamp equals
+		iSearchStamp; this way, the arrays don't need to be reset. */
+	std::vector<int> aiSearchStamp;
+	std::vector<int> aiSearchLabel;
+	int iSearchStamp = 0;
+
+	// advc.opt: Union-find over the searches of recalculatePlotsAfterRemoval
+	int findSearch(std::vector<int>& aiParent, int i)
+	{
+		while (aiParent[i] != i)
+		{
+			aiParent[i] = aiParent[aiParent[i]];
+			i = aiParent[i];
+		}
+		return i;
+	}
+
+	/*	advc.opt: Connected in either direction. Rebuilding a plot group
+		through CvPlot::updatePlotGroup would join two such plots too. */
+	bool isPlotGroupEdge(CvPlot const& kFrom, CvPlot const& kTo, TeamTypes eTeam)
+	{
+		return (kTo.isTradeNetwork(eTeam) &&
+				(kTo.isTradeNetworkConnected(kFrom, eTeam) ||
+				kFrom.isTradeNetworkConnected(kTo, eTeam)));
+	}
+}
+
 
 CvPlotGroup::CvPlotGroup()
 {
@@ -40,6 +70,7 @@ void CvPlotGroup::reset(int iID, PlayerTypes eOwner, bool bConstructorCall)
 	m_eOwner = eOwner;
 	if (!bConstructorCall)
 		m_aiNumBonuses.reset();
+	m_bDeferCityBonuses = false; // advc.opt
 }
 
 
@@ -150,6 +181,8 @@ void CvPlotGroup::changeNumBonuses(BonusTypes eBonus, int iChange)
 
 	//iOldNumBonuses = getNumBonuses(eBonus);
 	m_aiNumBonuses.add(eBonus, iChange);
+	if (m_bDeferCityBonuses) // advc.opt
+		return;
 
 	//FAssert(m_aiNumBonuses.get(eBonus) >= 0); // XXX
 	/*	K-Mod note, m_aiNumBonuses[eBonus] is often temporarily negative
@@ -192,6 +225,289 @@ void CvPlotGroup::verifyCityProduction()
 }
 
 
+/*	advc.opt: Called after kRemoved has been removed from this group. Checks
+	whether the rest of the group is still connected - through simultaneous
+	searches from the group's plots adjacent to kRemoved. Searches that meet
+	get merged (union-find); the check ends once all but one of the remaining
+	searches have run out of plots. That's usually near kRemoved, and, if the
+	group does fall apart, the searches only need to visit all plots of the
+	smaller parts. Those parts move to new plot groups; bonus counts get
+	passed on to the cities once per group, not per plot and bonus.
+	recalculatePlots, in contrast, searches the whole group and, if it has
+	split, rebuilds it plot by plot. */
+void CvPlotGroup::recalculatePlotsAfterRemoval(CvPlot const& kRemoved,
+	bool bVerifyProduction)
+{
+	PROFILE_FUNC();
+	PlayerTypes const eOwner = getOwner();
+	TeamTypes const eTeam = TEAMID(eOwner);
+	std::vector<CvPlot*> apSeeds;
+	FOR_EACH_ADJ_PLOT_VAR(kRemoved)
+	{
+		if (pAdj->getPlotGroup(eOwner) != this)
+			continue;
+		if (!pAdj->isTradeNetwork(eTeam))
+		{	// Group isn't in the state that this function expects
+			FErrorMsg("Plot group member outside of trade network");
+			recalculatePlots(bVerifyProduction);
+			return;
+		}
+		apSeeds.push_back(pAdj);
+	}
+	int const iSearches = (int)apSeeds.size();
+	// If kRemoved had only one neighbor in the group, it was at the edge.
+	if (iSearches <= 1)
+		return;
+
+	CvMap const& kMap = GC.getMap();
+	if ((int)aiSearchStamp.size() != kMap.numPlots())
+	{
+		aiSearchStamp.assign(kMap.numPlots(), 0);
+		aiSearchLabel.resize(kMap.numPlots());
+	}
+	iSearchStamp++;
+	// Plots visited by each search; those from index aiNext on are yet to be expanded.
+	std::vector<std::vector<CvPlot*> > aapVisited(iSearches);
+	std::vector<size_t> aiNext(iSearches, 0);
+	std::vector<int> aiParent(iSearches);
+	for (int i = 0; i < iSearches; i++)
+	{
+		aiParent[i] = i;
+		PlotNumTypes const ePlot = kMap.plotNum(*apSeeds[i]);
+		aiSearchStamp[ePlot] = iSearchStamp;
+		aiSearchLabel[ePlot] = i;
+		aapVisited[i].push_back(apSeeds[i]);
+	}
+	int iComponents = iSearches;
+	std::vector<bool> abUnfinished(iSearches);
+	while (iComponents > 1)
+	{
+		// Can stop once all but (at most) one component has been fully explored
+		abUnfinished.assign(iSearches, false);
+		int iUnfinished = 0;
+		for (int i = 0; i < iSearches; i++)
+		{
+			int const iRoot = findSearch(aiParent, i);
+			if (aiNext[i] < aapVisited[i].size() && !abUnfinished[iRoot])
+			{
+				abUnfinished[iRoot] = true;
+				iUnfinished++;
+			}
+		}
+		if (iUnfinished <= 1)
+			break;
+		// Expand one plot per search
+		for (int i = 0; i < iSearches; i++)
+		{
+			if (aiNext[i] >= aapVisited[i].size())
+				continue;
+			CvPlot const& kPlot = *aapVisited[i][aiNext[i]];
+			aiNext[i]++;
+			FOR_EACH_ADJ_PLOT_VAR(kPlot)
+			{
+				if (pAdj->getPlotGroup(eOwner) != this ||
+					!isPlotGroupEdge(kPlot, *pAdj, eTeam))
+				{
+					continue;
+				}
+				PlotNumTypes const eAdj = kMap.plotNum(*pAdj);
+				if (aiSearchStamp[eAdj] == iSearchStamp)
+				{
+					int const iRoot = findSearch(aiParent, i);
+					int const iAdjRoot = findSearch(aiParent, aiSearchLabel[eAdj]);
+					if (iRoot != iAdjRoot)
+					{
+						aiParent[iAdjRoot] = iRoot;
+						iComponents--;
+					}
+					continue;
+				}
+				aiSearchStamp[eAdj] = iSearchStamp;
+				aiSearchLabel[eAdj] = i;
+				aapVisited[i].push_back(pAdj);
+			}
+		}
+	}
+	if (iComponents <= 1)
+		return;
+
+	// The unfinished component, or else the largest one, stays in this group.
+	std::vector<int> aiComponentSize(iSearches, 0);
+	int iKeep = -1;
+	for (int i = 0; i < iSearches; i++)
+	{
+		int const iRoot = findSearch(aiParent, i);
+		aiComponentSize[iRoot] += (int)aapVisited[i].size();
+		if (aiNext[i] < aapVisited[i].size())
+			iKeep = iRoot;
+	}
+	if (iKeep < 0)
+	{
+		iKeep = 0;
+		for (int i = 0; i < iSearches; i++)
+		{
+			if (aiComponentSize[i] > aiComponentSize[iKeep])
+				iKeep = i;
+		}
+	}
+	// (Same rule as in recalculatePlots)
+	std::vector<CvCity*> apOldCities;
+	if (bVerifyProduction && m_iRecalculating == 0)
+		getCities(apOldCities);
+	std::vector<int> aiOldNumBonuses;
+	getNumBonuses(aiOldNumBonuses);
+	m_bDeferCityBonuses = true;
+	for (int iRoot = 0; iRoot < iSearches; iRoot++)
+	{
+		if (iRoot == iKeep || findSearch(aiParent, iRoot) != iRoot)
+			continue;
+		std::vector<CvPlot*> apPart;
+		for (int i = 0; i < iSearches; i++)
+		{
+			if (findSearch(aiParent, i) == iRoot)
+				apPart.insert(apPart.end(), aapVisited[i].begin(), aapVisited[i].end());
+		}
+		splitOff(apPart, aiOldNumBonuses);
+	}
+	m_bDeferCityBonuses = false;
+	// Drop the plots that have moved to other groups from the list
+	for (CLLNode<XYCoords>* pPlotNode = headPlotsNode(); pPlotNode != NULL; )
+	{
+		if (kMap.getPlot(pPlotNode->m_data.iX, pPlotNode->m_data.iY).
+			getPlotGroup(eOwner) != this)
+		{
+			pPlotNode = m_plots.deleteNode(pPlotNode);
+		}
+		else pPlotNode = nextPlotsNode(pPlotNode);
+	}
+	FAssert(getLengthPlots() > 0);
+	// The cities still here only need the difference
+	std::vector<int> aiChange;
+	getNumBonuses(aiChange);
+	for (size_t i = 0; i < aiChange.size(); i++)
+		aiChange[i] -= aiOldNumBonuses[i];
+	changeCityBonuses(aiChange);
+	for (size_t i = 0; i < apOldCities.size(); i++)
+		apOldCities[i]->verifyProduction();
+}
+
+/*	advc.opt: Moves apPlots into a new plot group. Helper function for
+	recalculatePlotsAfterRemoval; this group needs to defer its city bonus
+	updates, and aiOldNumBonuses are the bonus counts that the cities of this
+	group have. Doesn't remove apPlots from m_plots. */
+void CvPlotGroup::splitOff(std::vector<CvPlot*> const& apPlots,
+	std::vector<int> const& aiOldNumBonuses)
+{
+	FAssert(m_bDeferCityBonuses);
+	PlayerTypes const eOwner = getOwner();
+	CvPlotGroup& kNew = *GET_PLAYER(eOwner).addPlotGroup();
+	kNew.reset(kNew.getID(), eOwner);
+	kNew.m_bDeferCityBonuses = true;
+	for (size_t i = 0; i < apPlots.size(); i++)
+	{
+		CvPlot& kPlot = *apPlots[i];
+		CvCity* pCity = kPlot.getPlotCity();
+		if (pCity != NULL && pCity->getOwner() == eOwner)
+		{
+			FOR_EACH_ENUM(Bonus)
+			{
+				pCity->changeNumBonuses(eLoopBonus, -aiOldNumBonuses[eLoopBonus],
+						false); // (as in CvPlot::setPlotGroup)
+			}
+		}
+		bool const bOwned = (kPlot.getOwner() == eOwner);
+		if (bOwned)
+			kPlot.updatePlotGroupBonus(false, false);
+		kPlot.setPlotGroupNoBonusUpdate(eOwner, &kNew);
+		if (bOwned)
+			kPlot.updatePlotGroupBonus(true, false);
+		XYCoords xy;
+		xy.iX = kPlot.getX();
+		xy.iY = kPlot.getY();
+		kNew.insertAtEndPlots(xy);
+	}
+	kNew.m_bDeferCityBonuses = false;
+	std::vector<int> aiNumBonuses;
+	kNew.getNumBonuses(aiNumBonuses);
+	kNew.changeCityBonuses(aiNumBonuses);
+}
+
+/*	advc.opt: Moves all plots of kOld into this group, which deletes kOld.
+	Used to be done through addPlot, i.e. removing and re-adding the bonuses
+	of each plot, with each change being passed on to all cities. Now the
+	cities on each side just receive the bonus counts of the other side. */
+void CvPlotGroup::absorb(CvPlotGroup& kOld, bool bVerifyProduction)
+{
+	PROFILE_FUNC();
+	FAssert(&kOld != this && kOld.getOwner() == getOwner());
+	std::vector<int> aiNumBonuses;
+	getNumBonuses(aiNumBonuses);
+	std::vector<int> aiOldNumBonuses;
+	kOld.getNumBonuses(aiOldNumBonuses);
+	changeCityBonuses(aiOldNumBonuses);
+	kOld.changeCityBonuses(aiNumBonuses);
+	FOR_EACH_ENUM(Bonus)
+		m_aiNumBonuses.add(eLoopBonus, aiOldNumBonuses[eLoopBonus]);
+	CvMap const& kMap = GC.getMap();
+	for (CLLNode<XYCoords> const* pPlotNode = kOld.headPlotsNode(); pPlotNode != NULL;
+		pPlotNode = kOld.nextPlotsNode(pPlotNode))
+	{
+		kMap.getPlot(pPlotNode->m_data.iX, pPlotNode->m_data.iY).
+				setPlotGroupNoBonusUpdate(getOwner(), this);
+		insertAtEndPlots(pPlotNode->m_data);
+	}
+	kOld.m_plots.clear();
+	GET_PLAYER(getOwner()).deletePlotGroup(kOld.getID());
+	if (bVerifyProduction)
+		verifyCityProduction();
+}
+
+// advc.opt:
+void CvPlotGroup::getNumBonuses(std::vector<int>& aiNumBonuses) const
+{
+	aiNumBonuses.resize(GC.getNumBonusInfos());
+	FOR_EACH_ENUM(Bonus)
+		aiNumBonuses[eLoopBonus] = getNumBonuses(eLoopBonus);
+}
+
+// advc.opt: One pass through the plots for all bonuses
+void CvPlotGroup::changeCityBonuses(std::vector<int> const& aiChange)
+{
+	std::vector<BonusTypes> aeChanged;
+	FOR_EACH_ENUM(Bonus)
+	{
+		if (aiChange[eLoopBonus] != 0)
+			aeChanged.push_back(eLoopBonus);
+	}
+	if (aeChanged.empty())
+		return;
+	std::vector<CvCity*> apCities;
+	getCities(apCities);
+	for (size_t i = 0; i < apCities.size(); i++)
+	{
+		for (size_t j = 0; j < aeChanged.size(); j++)
+		{
+			apCities[i]->changeNumBonuses(aeChanged[j], aiChange[aeChanged[j]],
+					false); // advc.064d: Caller verifies production
+		}
+	}
+}
+
+// advc.opt: Cities of the group owner in this group
+void CvPlotGroup::getCities(std::vector<CvCity*>& apCities)
+{
+	CvMap const& kMap = GC.getMap();
+	for (CLLNode<XYCoords> const* pPlotNode = headPlotsNode(); pPlotNode != NULL;
+		pPlotNode = nextPlotsNode(pPlotNode))
+	{
+		CvCity* pCity = kMap.getPlot(pPlotNode->m_data.iX, pPlotNode->m_data.iY).
+				getPlotCity();
+		if (pCity != NULL && pCity->getOwner() == getOwner())
+			apCities.push_back(pCity);
+	}
+}
+
+
 CLLNode<XYCoords>* CvPlotGroup::deletePlotsNode(CLLNode<XYCoords>* pNode)
 {
 	CLLNode<XYCoords>* pPlotNode;
@@ -6,6 +6,7 @@
 #include "LinkedList.h"
 
 class CvPlot;
+class CvCity;
 
 
 class CvPlotGroup
@@ -22,6 +23,11 @@ public:
 	void addPlot(CvPlot* pPlot, /* advc.064d: */ bool bVerifyProduction = true);
 	void removePlot(CvPlot* pPlot, bool bVerifyProduction = true);
 	void recalculatePlots(/* advc.064d: */ bool bVerifyProduction = true);
+	// <advc.opt>
+	void recalculatePlotsAfterRemoval(CvPlot const& kRemoved,
+			bool bVerifyProduction = true);
+	void absorb(CvPlotGroup& kOld, bool bVerifyProduction = true);
+	// </advc.opt>
 
 	inline int getID() const { return m_iID; } // advc.inl
 	void setID(int iID) { m_iID = iID; } // advc.inl
@@ -56,6 +62,17 @@ protected:
 	PlayerTypes m_eOwner;
 	EnumMap<BonusTypes,int> m_aiNumBonuses; // advc.enum
 	CLinkList<XYCoords> m_plots;
+	/*	advc.opt: While set, changeNumBonuses doesn't pass the change on to the
+		cities; the caller then has to. Not serialized. */
+	bool m_bDeferCityBonuses;
+
+	// <advc.opt>
+	void getNumBonuses(std::vector<int>& aiNumBonuses) const;
+	void changeCityBonuses(std::vector<int> const& aiChange);
+	void getCities(std::vector<CvCity*>& apCities);
+	void splitOff(std::vector<CvPlot*> const& apPlots,
+			std::vector<int> const& aiOldNumBonuses);
+	// </advc.opt>
 };
 
 #endif
@@ -17,21 +17,28 @@
 // K-Mod:
 GroupPathFinder* CvSelectionGroup::m_pPathFinder = NULL; // advc.pf: pointer
 GroupPathFinder* CvSelectionGroup::m_pAltPathFinder = NULL; // advc.opt
+// <advc.opt>
+GroupPathFinder* CvSelectionGroup::m_pDefaultPathFinder = NULL;
+GroupPathCache* CvSelectionGroup::m_pPathCache = NULL; // </advc.opt>
 // <advc.pf>
 void CvSelectionGroup::initPathFinder()
 {
-	if (m_pPathFinder != NULL)
+	if (m_pDefaultPathFinder != NULL)
 	{
-		FAssert(m_pPathFinder == NULL);
-		delete m_pPathFinder;
+		FAssert(m_pDefaultPathFinder == NULL);
+		uninitPathFinder();
 	}
-	m_pPathFinder = new GroupPathFinder();
+	m_pDefaultPathFinder = new GroupPathFinder();
+	m_pPathFinder = m_pDefaultPathFinder;
 	m_pAltPathFinder = new GroupPathFinder();
+	m_pPathCache = new GroupPathCache(); // advc.opt
 }
 void CvSelectionGroup::uninitPathFinder()
 {
-	SAFE_DELETE(m_pPathFinder);
+	m_pPathFinder = NULL;
+	SAFE_DELETE(m_pDefaultPathFinder);
 	SAFE_DELETE(m_pAltPathFinder);
+	SAFE_DELETE(m_pPathCache); // advc.opt
 }
 /*	Restored this BtS function for callers that
 	otherwise don't need the GroupPathFinder header.
@@ -42,6 +49,18 @@ void CvSelectionGroup::resetPath()
 	pathFinder().reset();
 }
 
+// advc.opt:
+void CvSelectionGroup::invalidateSharedPaths()
+{
+	GroupPathCache::invalidate();
+}
+
+// advc.opt:
+void CvSelectionGroup::invalidatePathProfiles()
+{
+	GroupPathCache::invalidateProfiles();
+}
+
 GroupPathFinder& CvSelectionGroup::getClearPathFinder() // advc.opt
 {
 	/*	(Will use this in a place where cached data could cause OOS issues.
@@ -116,8 +135,9 @@ void CvSelectionGroup::kill()
 // advc.pf:
 void CvSelectionGroup::invalidateGroupPaths()
 {
-	m_pPathFinder->invalidateGroup(*this);
+	m_pDefaultPathFinder->invalidateGroup(*this); // advc.opt
 	m_pAltPathFinder->invalidateGroup(*this);
+	m_pPathCache->invalidateGroup(*this); // advc.opt
 }
 
 
@@ -3912,6 +3932,8 @@ bool CvSelectionGroup::generatePath(CvPlot const& kFrom, CvPlot const& kTo,
 	/*	Not getClearPathFinder -- want bTempFinder to work correctly even when called
 		while generating a path. */
 	GroupPathFinder tempFinder;
+	if (!bUseTempFinder)
+		bindPathFinder(eFlags); // advc.opt
 	GroupPathFinder& kPathFinder = (!bUseTempFinder ?
 			pathFinder() : tempFinder);
 	// </advc.128>
@@ -3937,6 +3959,29 @@ bool CvSelectionGroup::generatePath(CvPlot const& kFrom, CvPlot const& kTo,
 	return bSuccess;
 }
 
+// advc.opt:
+void CvSelectionGroup::generateReachMap(CvPlot const& kFrom, MovementFlags eFlags,
+	int iMaxPath) const
+{
+	PROFILE_FUNC();
+	FAssert(AI_isControlled());
+	// An unbounded sweep could cover a whole continent
+	FAssertMsg(iMaxPath >= 0 && iMaxPath < MAX_INT, "Reach map should be bounded");
+	bindPathFinder(eFlags);
+	GroupPathFinder& kPathFinder = pathFinder();
+	kPathFinder.setGroup(*this, eFlags, iMaxPath);
+	kPathFinder.generateReachMap(kFrom);
+}
+
+/*	advc.opt: Let pathFinder() refer to the nodes shared by groups with the same
+	movement profile as this group, or, if this group doesn't share paths,
+	to the default pathfinder. */
+void CvSelectionGroup::bindPathFinder(MovementFlags eFlags) const
+{
+	GroupPathFinder* pSharedFinder = m_pPathCache->lookup(*this, eFlags);
+	m_pPathFinder = (pSharedFinder != NULL ? pSharedFinder : m_pDefaultPathFinder);
+}
+
 
 void CvSelectionGroup::clearUnits()
 {
@@ -3980,6 +4025,7 @@ bool CvSelectionGroup::addUnit(CvUnit* pUnit, bool bMinimalChange)
 	}
 	if (!bAdded)
 		m_units.insertAtEnd(pUnit->getIDInfo());
+	AI().AI_setMovementPriorityDirty(); // advc.opt (head unit may have changed)
 
 	if(!bMinimalChange && getOwner() == NO_PLAYER && getNumUnits() > 0)
 	{
@@ -4035,6 +4081,7 @@ CLLNode<IDInfo>* CvSelectionGroup::deleteUnitNode(CLLNode<IDInfo>* pNode)
 		}
 	}
 	pNextUnitNode = m_units.deleteNode(pNode);
+	AI().AI_setMovementPriorityDirty(); // advc.opt
 	return pNextUnitNode;
 }
 
@@ -4,6 +4,7 @@
 #define CIV4_SELECTION_GROUP_H
 
 class GroupPathFinder;
+class GroupPathCache; // advc.opt
 class CvMap;
 class CvPlot;
 class CvArea;
@@ -27,6 +28,10 @@ public:
 		advc: I'm not going to expose it to Python again, but, in the DLL, it's helpful
 		as a (static) wrapper for avoiding inclusion of the GroupPathFinder header. */
 	static void resetPath();
+	// advc.opt: Discard the paths shared between groups (see GroupPathCache)
+	static void invalidateSharedPaths();
+	// advc.opt: Recompute the movement profiles of groups (see GroupPathCache)
+	static void invalidatePathProfiles();
 
 	CvSelectionGroup();
 	virtual ~CvSelectionGroup();
@@ -224,6 +229,11 @@ public:
 			bool bReuse = false, int* piPathTurns = NULL,
 			int iMaxPath = -1, // K-Mod
 			bool bUseTempFinder = false) const; // advc.128
+	/*	advc.opt: For AI target searches that check many destinations. Processes
+		all plots within iMaxPath turns of kFrom at once; subsequent generatePath
+		calls from kFrom with the same flags and at most iMaxPath turns are then
+		mere lookups - until the shared pathfinder gets used for another group. */
+	void generateReachMap(CvPlot const& kFrom, MovementFlags eFlags, int iMaxPath) const;
 
 	DllExport void clearUnits();
 	DllExport bool addUnit(CvUnit* pUnit, bool bMinimalChange);
@@ -316,6 +326,12 @@ protected:
 	/*	advc.opt: When we want to avoid resetting the path finder above,
 		and also want to avoid allocating memory. */
 	static GroupPathFinder* m_pAltPathFinder;
+	/*	<advc.opt> m_pPathFinder points to one of the GroupPathCache entries
+		when the last path was generated for an AI group that can share its paths
+		and to m_pDefaultPathFinder otherwise. */
+	static GroupPathFinder* m_pDefaultPathFinder;
+	static GroupPathCache* m_pPathCache;
+	void bindPathFinder(MovementFlags eFlags) const; // </advc.opt>
 
 	// WARNING: adding to this class will cause the civ4 exe to crash
 
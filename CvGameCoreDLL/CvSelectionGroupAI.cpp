@@ -122,6 +122,11 @@ bool CvSelectionGroupAI::AI_update()
 
 	if (getNumUnits() == 0)
 		return false;
+	/*	advc.opt: Combat caches only get invalidated upon the changes that
+		are most likely to occur while units move. Start each group afresh
+		to be safe. */
+	CvPlayerAI::AI_invalidateCombatCache();
+	CvSelectionGroup::invalidatePathProfiles(); // advc.opt
 
 	// K-Mod. (replacing the original "isForceUpdate" stuff.)
 	if (isForceUpdate())
@@ -802,6 +807,8 @@ CvUnit* CvSelectionGroupAI::AI_bestUnitForMission(MissionTypes eMission,
 
 void CvSelectionGroupAI::AI_queueGroupAttack(int iX, int iY)
 {
+	if (!m_bGroupAttack) // advc.opt
+		AI_setMovementPriorityDirty();
 	m_bGroupAttack = true;
 
 	m_iGroupAttackX = iX;
@@ -932,7 +939,8 @@ void CvSelectionGroupAI::AI_setMissionAI(MissionAITypes eNewMissionAI,
 	CvPlot const* pNewPlot, CvUnit const* pNewUnit) // advc: 2x const
 {
 	//PROFILE_FUNC();
-
+	if (eNewMissionAI != m_eMissionAIType) // advc.opt
+		AI_setMovementPriorityDirty();
 	m_eMissionAIType = eNewMissionAI;
 
 	if (pNewPlot != NULL)
@@ -952,6 +960,14 @@ void CvSelectionGroupAI::AI_setMissionAI(MissionAITypes eNewMissionAI,
 }
 
 
+// advc.opt:
+void CvSelectionGroupAI::AI_setMovementPriorityDirty() const
+{
+	if (getOwner() != NO_PLAYER)
+		GET_PLAYER(getOwner()).AI_setMovementPriorityDirty(getID());
+}
+
+
 CvUnitAI* CvSelectionGroupAI::AI_getMissionAIUnit() /* advc: */ const
 {
 	return ::AI_getUnit(m_missionAIUnit);
@@ -47,7 +47,14 @@ public:
 			CvPlot const* pMissionPlot = NULL); // </advc.004c>
 
 	void AI_queueGroupAttack(int iX, int iY);
-	inline void AI_cancelGroupAttack() { m_bGroupAttack = false; } // K-Mod (made inline)
+	inline void AI_cancelGroupAttack() // K-Mod (made inline)
+	{
+		if (m_bGroupAttack) // advc.opt
+		{
+			m_bGroupAttack = false;
+			AI_setMovementPriorityDirty(); // advc.opt
+		}
+	}
 	inline bool AI_isGroupAttack() const { return m_bGroupAttack; } // K-Mod (made inline)
 
 	bool AI_isControlled() const { return (!isHuman() || isAutomated()); } // advc.inl
@@ -66,6 +73,8 @@ public:
 		return m_eMissionAIType; // advc.inl: inline (now that it's no longer virtual)
 	}
 	void AI_setMissionAI(MissionAITypes eNewMissionAI, CvPlot const* pNewPlot, CvUnit const* pNewUnit);
+	// advc.opt: Let the owner re-key this group in its AI_unitUpdate queue
+	void AI_setMovementPriorityDirty() const;
 	// advc.003u: These two had returned CvUnit*
 	CvUnitAI* AI_ejectBestDefender(CvPlot* pTargetPlot);
 	CvUnitAI* AI_getMissionAIUnit() const;
@@ -5,6 +5,7 @@
 #include "CvAgents.h" // advc.agent
 #include "CoreAI.h"
 #include "UWAIAgent.h" // advc.104t
+#include "TeamPathCache.h" // advc.opt
 #include "CvCity.h"
 #include "CvUnit.h"
 #include "CvSelectionGroup.h"
@@ -233,6 +234,9 @@ void CvTeam::addTeam(TeamTypes eTeam)
 	FAssert(eTeam != getID());
 
 	int const iOriginalTeamSize = getNumMembers(); // K-Mod
+	CvTeamAI::AI_invalidatePathCaches(); // advc.opt
+	CvPlayerAI::AI_invalidateDangerCache(); // advc.opt
+	CvCity::invalidateTradeProfits(); // advc.opt
 
 	for (int i = 0; i < MAX_PLAYERS; i++)
 	{
@@ -2936,6 +2940,10 @@ void CvTeam::setAtWar(TeamTypes eIndex, bool bNewValue)
 	if(m_abAtWar.get(eIndex) == bNewValue)
 		return; // </advc.035>
 	m_abAtWar.set(eIndex, bNewValue);
+	AI().AI_pathCache().onTeamChanged(); // advc.opt
+	CvPlayerAI::AI_invalidateDangerCache(); // advc.opt
+	CvPlayerAI::AI_invalidateTradeValCache(); // advc.opt
+	CvCity::invalidateTradeProfits(); // advc.opt
 	// <advc.003m>
 	if (eIndex != BARBARIAN_TEAM)
 	{
@@ -3024,6 +3032,8 @@ void CvTeam::setOpenBorders(TeamTypes eIndex, bool bNewValue)
 		return; // advc
 	bool bOldFreeTrade = isFreeTrade(eIndex);
 	m_abOpenBorders.set(eIndex, bNewValue);
+	AI().AI_pathCache().onTeamChanged(); // advc.opt
+	CvPlayerAI::AI_invalidateDangerCache(); // advc.opt
 	// <advc.130p> OB affect diplo from rival trade
 	for (PlayerIter<MAJOR_CIV,NOT_SAME_TEAM_AS> itOther(getID()); itOther.hasNext(); ++itOther)
 	{
@@ -3178,6 +3188,10 @@ void CvTeam::setVassal(TeamTypes eMaster, bool bNewValue, bool bCapitulated)
 		isCapitulated()==bCapitulated here. */
 	if (isVassal(eMaster) == bNewValue)
 		return; // <advc>
+	/*	advc.opt: Affects territory access and the masters of war targets
+		assumed by all path caches */
+	CvTeamAI::AI_invalidatePathCaches();
+	CvPlayerAI::AI_invalidateDangerCache(); // advc.opt
 	for (MemberIter it(getID()); it.hasNext(); ++it)
 		it->updateCitySight(false, false);
 
@@ -3249,11 +3263,12 @@ void CvTeam::setVassal(TeamTypes eMaster, bool bNewValue, bool bCapitulated)
 		it->updateCitySight(true, false);
 
 	CvMap const& kMap = GC.getMap();
+	CvMap::PlotFields const& kFields = kMap.getPlotFields(); // advc.opt
 	for (int i = 0; i < kMap.numPlots(); ++i)
 	{
-		CvPlot& kLoopPlot = kMap.getPlotByIndex(i);
-		if (kLoopPlot.getTeam() == getID() || kLoopPlot.getTeam() == eMaster)
-			kLoopPlot.updateCulture(true, false);
+		TeamTypes const ePlotTeam = kFields.getTeam(i); // advc.opt
+		if (ePlotTeam == getID() || ePlotTeam == eMaster)
+			kMap.getPlotByIndex(i).updateCulture(true, false);
 	}
 
 	/*	advc.064d (note): m_bCapitulated hasn't been set yet. If the
@@ -3640,6 +3655,8 @@ void CvTeam::triggerWars(bool bForceUpdateAttitude)
 void CvTeam::changeRouteChange(RouteTypes eIndex, int iChange)
 {
 	m_aiRouteChange.add(eIndex, iChange);
+	AI().AI_pathCache().onTeamChanged(); // advc.opt
+	CvPlayerAI::AI_invalidateDangerCache(); // advc.opt
 }
 
 
@@ -4295,6 +4312,8 @@ void CvTeam::setHasTech(TechTypes eTech, bool bNewValue, PlayerTypes ePlayer,
 
 	if (isHasTech(eTech) == bNewValue)
 		return;
+	CvPlayerAI::AI_invalidateDangerCache(); // advc.opt
+	CvPlayerAI::AI_invalidateTradeValCache(); // advc.opt
 
 	if (ePlayer == NO_PLAYER)
 		ePlayer = getLeaderID();
@@ -5205,14 +5224,16 @@ void CvTeam::updateTechShare()
 void CvTeam::updatePlotGroupBonus(TechTypes eTech, bool bAdd)
 {
 	CvMap const& kMap = GC.getMap();
+	// advc.opt: Check team and resource without loading the CvPlot objects
+	CvMap::PlotFields const& kFields = kMap.getPlotFields();
 	for (int i = 0; i < kMap.numPlots(); i++)
 	{
-		CvPlot& kPlot = kMap.getPlotByIndex(i);
-		if (kPlot.getTeam() != getID())
+		if (kFields.getTeam(i) != getID())
 			continue;
-		BonusTypes eBonus = kPlot.getBonusType();
+		BonusTypes eBonus = kFields.getBonusType(i);
 		if (eBonus == NO_BONUS)
 			continue;
+		CvPlot& kPlot = kMap.getPlotByIndex(i);
 		CvBonusInfo const& kBonus = GC.getInfo(eBonus);
 		if (kBonus.getTechReveal() == eTech || kBonus.getTechCityTrade() == eTech ||
 			kBonus.getTechObsolete() == eTech)
@@ -4,6 +4,8 @@
 #include "CoreAI.h"
 #include "CvCityAI.h"
 #include "TeamPathFinder.h"
+#include "TeamPathCache.h" // advc.opt
+#include "CvSelectionGroup.h" // advc.opt (for invalidateSharedPaths)
 #include "CityPlotIterator.h"
 #include "CvArea.h"
 #include "CvInfo_City.h"
@@ -23,6 +25,7 @@ DllExport CvTeamAI& CvTeamAI::getTeamNonInl(TeamTypes eTeam)
 CvTeamAI::CvTeamAI(/* advc.003u: */ TeamTypes eID) : CvTeam(eID)
 {
 	m_pUWAI = new UWAI::Team(); // advc.104
+	m_pPathCache = new TeamPathCache(); // advc.opt
 	AI_reset(true);
 }
 
@@ -31,6 +34,7 @@ CvTeamAI::~CvTeamAI()
 {
 	AI_uninit();
 	SAFE_DELETE(m_pUWAI); // advc.104
+	SAFE_DELETE(m_pPathCache); // advc.opt
 }
 
 
@@ -92,6 +96,31 @@ void CvTeamAI::AI_reset(bool bConstructor)
 	m_bLonely = false; // advc.109
 	m_religionKnownSince.clear(); // advc.130n
 	m_strengthMemory.reset(); // advc.158
+	// <advc.opt>
+	m_aiTechTradeValCache.clear();
+	m_iTechTradeValCacheEpoch = -1;
+	if (getID() != NO_TEAM)
+		m_pPathCache->init(getID());
+	else m_pPathCache->reset(); // </advc.opt>
+}
+
+
+// advc.opt:
+void CvTeamAI::AI_invalidatePathCaches(CvPlot const& kPlot)
+{
+	/*	Not using TeamIter b/c this also gets called during map generation.
+		(Caches of dead teams are empty, so there's no point in checking.) */
+	for (int i = 0; i < MAX_TEAMS; i++)
+		AI_getTeam((TeamTypes)i).AI_pathCache().onPlotChanged(kPlot);
+	CvSelectionGroup::invalidateSharedPaths();
+}
+
+// advc.opt:
+void CvTeamAI::AI_invalidatePathCaches()
+{
+	for (int i = 0; i < MAX_TEAMS; i++)
+		AI_getTeam((TeamTypes)i).AI_pathCache().reset();
+	CvSelectionGroup::invalidateSharedPaths();
 }
 
 
@@ -1910,6 +1939,22 @@ int CvTeamAI::AI_techTradeVal(TechTypes eTech, TeamTypes eFromTeam,
 {
 	PROFILE_FUNC(); // advc.550: Still seems completely harmless wrt. performance
 	FAssert(eFromTeam != getID());
+	// <advc.opt>
+	int* piCached = NULL;
+	int const iCacheEpoch = CvPlayerAI::AI_getTradeValCacheEpoch();
+	if (CvPlayerAI::AI_isTradeValCacheActive() && !bIgnoreDiscount && !bPeaceDeal &&
+		eFromTeam < MAX_CIV_TEAMS)
+	{
+		int const iTechs = GC.getNumTechInfos();
+		if (m_iTechTradeValCacheEpoch != iCacheEpoch)
+		{
+			m_aiTechTradeValCache.assign(MAX_CIV_TEAMS * iTechs, MIN_INT);
+			m_iTechTradeValCacheEpoch = iCacheEpoch;
+		}
+		piCached = &m_aiTechTradeValCache[eFromTeam * iTechs + eTech];
+		if (*piCached != MIN_INT)
+			return *piCached;
+	} // </advc.opt>
 
 	CvTechInfo const& kTech = GC.getInfo(eTech);
 	scaled rValue = (fixp(0.25) + // advc.551: was 0.5
@@ -1999,7 +2044,11 @@ int CvTeamAI::AI_techTradeVal(TechTypes eTech, TeamTypes eFromTeam,
 			rValue *= rModifier;
 		}
 	} // </advc.550g>
-	return AI_roundTradeVal(rValue.round()); // advc.104k
+	int const iR = AI_roundTradeVal(rValue.round()); // advc.104k
+	// advc.opt: Not if the cache got invalidated meanwhile
+	if (piCached != NULL && iCacheEpoch == CvPlayerAI::AI_getTradeValCacheEpoch())
+		*piCached = iR;
+	return iR;
 }
 
 
@@ -3960,10 +4009,13 @@ bool CvTeamAI::AI_isTerritoryAccessible(TeamTypes eOwner) const
 			}
 		}
 	}
+	CvMap::PlotFields const& kFields = GC.getMap().getPlotFields(); // advc.opt
 	for (int i = 0; i < GC.getMap().numPlots(); i++)
 	{
+		if (kFields.getTeam(i) != eOwner) // advc.opt
+			continue;
 		CvPlot const& kPlot = GC.getMap().getPlotByIndex(i);
-		if (kPlot.getTeam() == eOwner && kPlot.isRevealed(getID()) && !kPlot.isWater())
+		if (kPlot.isRevealed(getID()) && !kPlot.isWater())
 		{
 			bLandFound = true;
 			if (AI_isTerritoryAccessible(kPlot))
@@ -4245,6 +4297,7 @@ void CvTeamAI::AI_setAtPeaceCounter(TeamTypes eIndex, int iNewValue)
 {
 	m_aiAtPeaceCounter.set(eIndex, iNewValue);
 	FAssert(AI_getAtPeaceCounter(eIndex) >= 0);
+	CvCity::invalidateTradeProfits(); // advc.opt
 }
 
 
@@ -4622,6 +4675,7 @@ void CvTeamAI::AI_setWarPlan(TeamTypes eTarget, WarPlanTypes eNewValue, bool bWa
 		return;
 	AI_updateWarPlanCounts(eTarget, m_aeWarPlan.get(eTarget), eNewValue); // advc.opt
 	m_aeWarPlan.set(eTarget, eNewValue);
+	CvPlayerAI::AI_invalidateDangerCache(); // advc.opt
 	AI_setWarPlanStateCounter(eTarget, 0);
 	// <advc.104d> Make per-area targets dirty
 	if (eNewValue != WARPLAN_PREPARING_LIMITED && eNewValue != WARPLAN_PREPARING_TOTAL &&
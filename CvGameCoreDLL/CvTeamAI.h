@@ -9,6 +9,7 @@
 #include "UWAI.h" // advc.104
 #include "AIStrengthMemoryMap.h" // advc.158
 #include "AIStrategies.h" // advc.enum
+class TeamPathCache; // advc.opt
 
 // <advc.003u> Let the more powerful macros take precedence
 #if !defined(CIV4_GAME_PLAY_H) && !defined(COREAI_H)
@@ -269,6 +270,12 @@ public:
 	// BETTER_BTS_AI_MOD: END
 	// advc.158:
 	inline AIStrengthMemoryMap& AI_strengthMemory() const { return m_strengthMemory; }
+	// <advc.opt>
+	inline TeamPathCache& AI_pathCache() const { return *m_pPathCache; }
+	// Remove path cache entries affected by a change at kPlot (all teams)
+	static void AI_invalidatePathCaches(CvPlot const& kPlot);
+	static void AI_invalidatePathCaches(); // Clear all path caches
+	// </advc.opt>
 	// advc.104:
 	void AI_setWarPlanNoUpdate(TeamTypes eIndex, WarPlanTypes eNewValue);
 	int AI_teamCloseness(TeamTypes eIndex, int iMaxDistance = -1,
@@ -328,6 +335,7 @@ protected:
 	bool m_bLonely; // advc.109
 
 	mutable AIStrengthMemoryMap m_strengthMemory; // advc.158
+	TeamPathCache* m_pPathCache; // advc.opt
 	UWAI::Team* m_pUWAI; // advc.104
 
 	int AI_noTechTradeThreshold() const;
@@ -348,6 +356,11 @@ protected:
 	// advc: Chunk of code that occured twice in doWar
 	void AI_abandonWarPlanIfTimedOut(int iAbandonTimeModifier, TeamTypes eTarget,
 			bool bLimited, int iEnemyPowerPercent);
+	/*	<advc.opt> AI_techTradeVal without discount and peace modifiers by
+		(eFromTeam, eTech); MIN_INT if not cached. See
+		CvPlayerAI::AI_invalidateTradeValCache. */
+	mutable std::vector<int> m_aiTechTradeValCache;
+	mutable int m_iTechTradeValCacheEpoch; // </advc.opt>
 	// advc.opt:
 	void AI_updateWarPlanCounts(TeamTypes eTarget, WarPlanTypes eOldPlan, WarPlanTypes eNewPlan);
 	// advc.104o:
@@ -17,6 +17,7 @@
 #include "BBAILog.h" // BETTER_BTS_AI_MOD, AI logging, 02/24/10, jdog5000
 #include "CvBugOptions.h" // advc.002e
 #include "CvDLLPythonIFaceBase.h" // for CvEventReporter::genericEvent
+#include "CvGameTextMgr.h" // advc.opt
 
 
 CvUnit::CvUnit() // advc.003u: Body cut from the deleted reset function
@@ -2159,6 +2160,12 @@ bool CvUnit::generatePath(CvPlot const& kTo, MovementFlags eFlags, bool bReuse,
 			iMaxPath, bUseTempFinder);
 }
 
+// advc.opt: See CvSelectionGroup::generateReachMap
+void CvUnit::generateReachMap(MovementFlags eFlags, int iMaxPath) const
+{
+	getGroup()->generateReachMap(getPlot(), eFlags, iMaxPath);
+}
+
 // K-Mod: Return the standard pathfinder, for extracting path information.
 GroupPathFinder& CvUnit::getPathFinder() const
 {
@@ -7398,6 +7405,29 @@ bool CvUnit::canBeAttackedBy(PlayerTypes eAttackingPlayer,
 }
 
 
+/*	advc.opt: For sharing cached best defenders (CvPlot::getBestDefender)
+	between the units of a stack. Compares everything that the attacker's side
+	of a combat depends on; errs on the side of returning false. */
+bool CvUnit::isCombatEquivalent(CvUnit const& kOther) const
+{
+	if (&kOther == this)
+		return true;
+	if (getUnitType() != kOther.getUnitType() || getOwner() != kOther.getOwner() ||
+		getDamage() != kOther.getDamage() || plot() != kOther.plot() ||
+		getAttackPlot() != kOther.getAttackPlot() || isCargo() != kOther.isCargo() ||
+		baseCombatStr() != kOther.baseCombatStr())
+	{
+		return false;
+	}
+	FOR_EACH_ENUM(Promotion)
+	{
+		if (isHasPromotion(eLoopPromotion) != kOther.isHasPromotion(eLoopPromotion))
+			return false;
+	}
+	return true;
+}
+
+
 bool CvUnit::isBetterDefenderThan(const CvUnit* pDefender, const CvUnit* pAttacker,
 	int* pBestDefenderRank, // Lead From Behind by UncutDragon
 	bool bPreferUnowned) const // advc.061
@@ -8306,6 +8336,10 @@ void CvUnit::setXY(int iX, int iY, bool bGroup, bool bUpdate, bool bShow, bool b
 		}
 	}*/
 	PROFILE_FUNC(); // advc
+	// <advc.opt> Danger near the old plot and the new plot
+	invalidateAIDangerCaches();
+	if (iX != INVALID_PLOT_COORD && iY != INVALID_PLOT_COORD)
+		CvPlayerAI::AI_invalidateDangerCache(GC.getMap().getPlot(iX, iY)); // </advc.opt>
 
 	FAssert(!at(iX, iY));
 	FAssert(!isFighting());
@@ -8401,10 +8435,16 @@ void CvUnit::setXY(int iX, int iY, bool bGroup, bool bUpdate, bool bShow, bool b
 	}
 
 	CvPlot* pOldPlot = plot();
+	/*	advc.opt: Update the sight in one step (only the plots whose visibility
+		changes) when the new plot gets processed. Not when capturing a city;
+		acquireCity needs to see our visibility without the old footprint. */
+	bool const bMoveSight = (pOldPlot != NULL && pNewPlot != NULL &&
+			!m_pUnitInfo->isLineOfSight() && !isEnemyCity(*pNewPlot));
 	if (pOldPlot != NULL)
 	{
 		pOldPlot->removeUnit(this, bUpdate && !hasCargo());
-		pOldPlot->changeAdjacentSight(getTeam(), visibilityRange(), false, this, true);
+		if (!bMoveSight) // advc.opt
+			pOldPlot->changeAdjacentSight(getTeam(), visibilityRange(), false, this, true);
 		pOldPlot->getArea().changeUnitsPerPlayer(getOwner(), -1);
 		pOldPlot->getArea().changePower(getOwner(), -m_pUnitInfo->getPowerValue());
 
@@ -8514,7 +8554,14 @@ void CvUnit::setXY(int iX, int iY, bool bGroup, bool bUpdate, bool bShow, bool b
 
 		setFortifyTurns(0);
 		// needs to be here so that the square is considered visible when we move into it...
-		pNewPlot->changeAdjacentSight(getTeam(), visibilityRange(), true, this, true);
+		// <advc.opt>
+		if (bMoveSight)
+		{
+			CvPlot::moveAdjacentSight(*pOldPlot, *pNewPlot,
+					getTeam(), visibilityRange(), *this, true);
+		}
+		else // </advc.opt>
+			pNewPlot->changeAdjacentSight(getTeam(), visibilityRange(), true, this, true);
 
 		pNewPlot->addUnit(*this, bUpdate && !hasCargo());
 
@@ -8781,6 +8828,8 @@ void CvUnit::setDamage(int iNewValue, PlayerTypes ePlayer, bool bNotifyEntity)
 
 	if (iOldValue != getDamage())
 	{
+		setGroupMovementPriorityDirty(); // advc.opt
+		CvPlayerAI::AI_invalidateCombatCache(); // advc.opt
 		if (GC.getGame().isFinalInitialized() && bNotifyEntity)
 			NotifyEntity(MISSION_DAMAGE);
 
@@ -8798,6 +8847,22 @@ void CvUnit::setDamage(int iNewValue, PlayerTypes ePlayer, bool bNotifyEntity)
 }
 
 
+// advc.opt:
+void CvUnit::setGroupMovementPriorityDirty() const
+{
+	if (getGroupID() != FFreeList::INVALID_INDEX)
+		GET_PLAYER(getOwner()).AI_setMovementPriorityDirty(getGroupID());
+}
+
+// advc.opt: Only the danger counts near our plot can be affected
+void CvUnit::invalidateAIDangerCaches() const
+{
+	if (plot() != NULL)
+		CvPlayerAI::AI_invalidateDangerCache(getPlot());
+	CvPlayerAI::AI_invalidateCombatCache();
+}
+
+
 void CvUnit::changeDamage(int iChange, PlayerTypes ePlayer)
 {
 	setDamage((getDamage() + iChange), ePlayer);
@@ -8848,6 +8913,8 @@ void CvUnit::setExperience(int iNewValue, int iMax)
 	{
 		m_iExperience = std::min(((iMax == -1) ? MAX_INT : iMax), iNewValue);
 		FAssert(getExperience() >= 0);
+		// advc.opt: LFBgetRelativeValueRating uses the experience
+		CvPlayerAI::AI_invalidateCombatCache();
 		if (IsSelected())
 			gDLL->UI().setDirty(InfoPane_DIRTY_BIT, true);
 	}
@@ -8892,6 +8959,7 @@ void CvUnit::setLevel(int iNewValue)
 	{
 		m_iLevel = iNewValue;
 		FAssert(getLevel() >= 0);
+		CvPlayerAI::AI_invalidateCombatCache(); // advc.opt (as in setExperience)
 
 		if (getLevel() > GET_PLAYER(getOwner()).getHighestUnitLevel())
 			GET_PLAYER(getOwner()).setHighestUnitLevel(getLevel());
@@ -8999,6 +9067,7 @@ void CvUnit::setFortifyTurns(int iNewValue)
 	if (iNewValue != getFortifyTurns())
 	{
 		m_iFortifyTurns = iNewValue;
+		CvPlayerAI::AI_invalidateCombatCache(); // advc.opt
 		setInfoBarDirty(true);
 	}
 }
@@ -9393,6 +9462,7 @@ void CvUnit::changeImmobileTimer(int iChange)
 void CvUnit::setMadeAttack(bool bNewValue)
 {
 	//m_bMadeAttack = bNewValue;
+	invalidateAIDangerCaches(); // advc.opt
 	// <advc.164>
 	if(bNewValue)
 		m_iMadeAttacks++;
@@ -9486,6 +9556,8 @@ bool CvUnit::isInfoBarDirty() const
 void CvUnit::setInfoBarDirty(bool bNewValue)
 {
 	m_bInfoBarDirty = bNewValue;
+	if (bNewValue) // advc.opt
+		CvGameTextMgr::invalidateHelpTextCache();
 }
 
 bool CvUnit::isBlockading() const
@@ -9722,9 +9794,13 @@ void CvUnit::setTransportUnit(CvUnit* pTransportUnit)
 
 	if (pOldTransportUnit == pTransportUnit)
 		return;
+	invalidateAIDangerCaches(); // advc.opt
 
 	if (pOldTransportUnit != NULL)
+	{
 		pOldTransportUnit->changeCargo(-1);
+		pOldTransportUnit->setGroupMovementPriorityDirty(); // advc.opt
+	}
 
 	if (pTransportUnit != NULL)
 	{
@@ -9756,6 +9832,7 @@ void CvUnit::setTransportUnit(CvUnit* pTransportUnit)
 			finishMoves();
 
 		pTransportUnit->changeCargo(1);
+		pTransportUnit->setGroupMovementPriorityDirty(); // advc.opt
 		pTransportUnit->getGroup()->setActivityType(ACTIVITY_AWAKE);
 	}
 	else
@@ -10022,6 +10099,9 @@ void CvUnit::setHasPromotion(PromotionTypes ePromotion, bool bNewValue)
 {
 	if(isHasPromotion(ePromotion) == bNewValue)
 		return;
+	invalidateAIDangerCaches(); // advc.opt
+	setGroupMovementPriorityDirty(); // advc.opt
+	CvSelectionGroup::invalidatePathProfiles(); // advc.opt
 
 	m_abHasPromotion.set(ePromotion, bNewValue);
 
@@ -50,6 +50,7 @@ public:
 			int* piPathTurns = NULL,
 			int iMaxPath = -1, // K-Mod
 			bool bUseTempFinder = false) const; // advc.128
+	void generateReachMap(MovementFlags eFlags, int iMaxPath) const; // advc.opt
 	GroupPathFinder& getPathFinder() const; // K-Mod
 	// <advc>
 	void pushGroupMoveTo(CvPlot const& kTo, MovementFlags eFlags = NO_MOVEMENT_FLAGS,
@@ -605,6 +606,11 @@ public:
 	void setID(int iID);
 
 	int getGroupID() const { return m_iGroupID; }															// Exposed to Python
+	// advc.opt: For CvPlayerAI::AI_unitUpdate; to be called when our group's priority may change.
+	void setGroupMovementPriorityDirty() const;
+	/*	advc.opt: To be called when our position or a status that the AI danger
+		counts and combat caches depend on changes */
+	void invalidateAIDangerCaches() const;
 	// advc: I don't think a unit is ever supposed to not be in a group
 	//bool isInGroup() const; // Exposed to Python ( advc: still available to Python; see CyUnit.cpp.)
 	bool isGroupHead() const;																				// Exposed to Python
@@ -1014,6 +1020,8 @@ public:
 
 	bool isWorker() const; // advc.154  (Exposed to Python)
 
+	// advc.opt: Would kOther, as an attacker, fare the same as this unit against any defender?
+	bool isCombatEquivalent(CvUnit const& kOther) const;
 	bool isBetterDefenderThan(const CvUnit* pDefender, const CvUnit* pAttacker,
 	// Lead From Behind (UncutDragon, edited for K-Mod): START
 			int* pBestDefenderRank,
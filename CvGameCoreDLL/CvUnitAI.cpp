@@ -1040,6 +1040,7 @@ void CvUnitAI::AI_setUnitAIType(UnitAITypes eNewValue)
 		GET_PLAYER(getOwner()).AI_changeNumAIUnits(AI_getUnitAIType(), -1);
 
 		m_eUnitAIType = eNewValue;
+		setGroupMovementPriorityDirty(); // advc.opt
 
 		getArea().changeNumAIUnits(getOwner(), AI_getUnitAIType(), 1);
 		GET_PLAYER(getOwner()).AI_changeNumAIUnits(AI_getUnitAIType(), 1);
@@ -10161,6 +10162,7 @@ bool CvUnitAI::AI_guardCity(bool bLeave, bool bSearch, int iMaxPath, MovementFla
 	if (bSearch)
 	{
 		int iBestValue = 0;
+		bool bReachMap = false; // advc.opt
 		//bool const bMoveAllTerrain = getGroup()->canMoveAllTerrain(); // advc
 		FOR_EACH_CITYAI(pLoopCity, kOwner) // advc: Flattened the body of this loop
 		{
@@ -10208,12 +10210,18 @@ bool CvUnitAI::AI_guardCity(bool bLeave, bool bSearch, int iMaxPath, MovementFla
 			{
 				continue;
 			}
-			int iPathTurns;
-			if (at(pLoopCity->getPlot()) || !generatePath(pLoopCity->getPlot(),
-				eFlags, true, &iPathTurns, iMaxPath))
+			if (at(pLoopCity->getPlot()))
+				continue;
+			/*	<advc.opt> Likely to check further cities. Unbounded reach maps
+				would be too costly. */
+			if (!bReachMap && iMaxPath < MAX_INT)
 			{
+				generateReachMap(eFlags, iMaxPath);
+				bReachMap = true;
+			} // </advc.opt>
+			int iPathTurns;
+			if (!generatePath(pLoopCity->getPlot(), eFlags, true, &iPathTurns, iMaxPath))
 				continue;
-			}
 			if (iPathTurns > iMaxPath)
 				continue;
 
@@ -13066,6 +13074,7 @@ CvCity* CvUnitAI::AI_pickTargetCity(MovementFlags eFlags, int iMaxPathTurns, boo
 	//GroupPathFinder transportPath;
 	GroupPathFinder& kTransportPath = CvSelectionGroup::getClearPathFinder(); // advc.opt
 	// K-Mod end
+	bool bReachMap = false; // advc.opt
 
 	CvCity* pTargetCity =  // advc.300:
 			(isBarbarian() && getArea().getCitiesPerPlayer(BARBARIAN_PLAYER) <= 0 ? NULL :
@@ -13087,6 +13096,12 @@ CvCity* CvUnitAI::AI_pickTargetCity(MovementFlags eFlags, int iMaxPathTurns, boo
 				continue;
 			if (kOwner.AI_deduceCitySite(*pLoopCity))
 			{
+				// <advc.opt> Cities of all rivals in the area get checked
+				if (!bReachMap && iMaxPathTurns < MAX_INT)
+				{
+					generateReachMap(eFlags, iMaxPathTurns);
+					bReachMap = true;
+				} // </advc.opt>
 				// K-Mod. Look for either a direct land path, or a sea transport path.
 				int iPathTurns = MAX_INT;
 				bool const bLandPath = generatePath(pLoopCity->getPlot(), eFlags, true,
@@ -14860,6 +14875,7 @@ bool CvUnitAI::AI_pillageRange(int iRange, int iBonusValueThreshold, MovementFla
 	CvPlot* pBestPlot = NULL;
 	CvPlot* pBestPillagePlot = NULL;
 	int iBestValue = 0;
+	bool bReachMap = false; // advc.opt
 	for (SquareIter it(*this, AI_searchRange(iRange)); it.hasNext(); ++it)
 	{
 		CvPlot& p = *it;
@@ -14882,14 +14898,21 @@ bool CvUnitAI::AI_pillageRange(int iRange, int iBonusValueThreshold, MovementFla
 			isBarbarian()) &&
 			canPillage(p))
 		{
-			int iPathTurns;
 			if(p.isVisibleEnemyUnit(this) ||
 				GET_PLAYER(getOwner()).AI_isAnyPlotTargetMissionAI(
-				p, MISSIONAI_PILLAGE, getGroup()) ||
-				!generatePath(p, eFlags, true, &iPathTurns, iRange))
+				p, MISSIONAI_PILLAGE, getGroup()))
 			{
 				continue;
 			}
+			// <advc.opt> One sweep for all the pillage targets in range
+			if (!bReachMap)
+			{
+				generateReachMap(eFlags, iRange);
+				bReachMap = true;
+			} // </advc.opt>
+			int iPathTurns;
+			if (!generatePath(p, eFlags, true, &iPathTurns, iRange))
+				continue;
 			if (getPathFinder().getFinalMoves() == 0)
 				iPathTurns++;
 
@@ -18223,6 +18246,9 @@ bool CvUnitAI::AI_retreatToCity(bool bPrimary, bool bPrioritiseAirlift, int iMax
 		? 1 : 0); iPass < 3; iPass++)
 	{
 		bool bNeedsAirlift = false;
+		MovementFlags const eFlags = (iPass >= 2 ? // was iPass >= 3
+				MOVE_IGNORE_DANGER : NO_MOVEMENT_FLAGS); // advc
+		bool bReachMap = false; // advc.opt
 		FOR_EACH_CITYAI(pLoopCity, kOwner)
 		{
 			if (!AI_plotValid(pLoopCity->plot()))
@@ -18245,10 +18271,14 @@ bool CvUnitAI::AI_retreatToCity(bool bPrimary, bool bPrioritiseAirlift, int iMax
 			{
 				continue;
 			} // </advc.139>
+			// <advc.opt>
+			if (!bReachMap && iMaxPath < MAX_INT)
+			{
+				generateReachMap(eFlags, iMaxPath);
+				bReachMap = true;
+			} // </advc.opt>
 			int iPathTurns=-1;
-			if (generatePath(pLoopCity->getPlot(),
-				iPass >= 2 ? MOVE_IGNORE_DANGER : NO_MOVEMENT_FLAGS, // was iPass >= 3
-				true, &iPathTurns, iMaxPath)) 
+			if (generatePath(pLoopCity->getPlot(), eFlags, true, &iPathTurns, iMaxPath))
 			{/* (comment by jdog5000, 08/19/09)
 				Water units can't defend a city
 				Any unthreatened city acceptable on 0th pass, solves problem where sea units
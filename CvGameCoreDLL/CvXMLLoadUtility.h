@@ -16,6 +16,7 @@ class FXml;
 class CvGameText;
 class CvCacheObject;
 class CvImprovementBonusInfo;
+class XMLBinaryCache; // advc.opt
 
 
 class CvXMLLoadUtility /* advc.003k: */ : private boost::noncopyable
@@ -222,7 +223,8 @@ private:
 
 	void SetGlobalAnimationPathInfo(CvAnimationPathInfo** ppAnimationPathInfo, char* szTagName, int* iNumVals);
 	//void SetGameText(const char* szTextGroup, const char* szTagName);
-	void SetGameText(const char* szTextGroup, const char* szTagName, const std::string& language_name); // K-Mod
+	void SetGameText(const char* szTextGroup, const char* szTagName, const std::string& language_name, // K-Mod
+			XMLBinaryCache* pCache = NULL); // advc.opt
 
 	/*	<advc.006g> (The BtS code sometimes said "XML Error", sometimes "XML Load Error"
 		not sure if that's meaningful, but I'm going to preserve it.)*/
@@ -9,6 +9,8 @@
 #include "CvInfo_All.h"
 #include "CvGameAI.h" // advc.104x
 #include "FVariableSystem.h"
+#include "XMLBinaryCache.h" // advc.opt
+#include "XMLPrefetcher.h" // advc.opt
 // <advc> Overwrite the definition in CvGlobals.h b/c a const GC is no use here
 #undef GC
 #define GC CvGlobals::getInstance() // </advc>
@@ -172,6 +174,9 @@ bool CvXMLLoadUtility::ReadGlobalDefines(const TCHAR* szXMLFileName, CvCacheObje
 bool CvXMLLoadUtility::SetGlobalDefines()
 {
 	UpdateProgressCB("GlobalDefines");
+	/*	advc.opt: First XML loading function that the EXE calls. Warm up the
+		file cache for the info classes while the defines get parsed. */
+	XMLPrefetcher::start();
 
 	//
 	// use disk cache if possible.
@@ -181,46 +186,63 @@ bool CvXMLLoadUtility::SetGlobalDefines()
 	#if ENABLE_XML_FILE_CACHE
 	cache = gDLL->createGlobalDefinesCacheObject("GlobalDefines.dat");	// cache file name
 	#endif
-	if (!ReadGlobalDefines("xml\\GlobalDefines.xml", cache))
-		return false;
-
-	if (!ReadGlobalDefines("xml\\GlobalDefinesAlt.xml", cache))
-		return false;
-
-	if (!ReadGlobalDefines("xml\\PythonCallbackDefines.xml", cache))
-		return false;
-
-	// <advc.009> Load additional GlobalDefines files
-	if(!ReadGlobalDefines("xml\\GlobalDefines_devel.xml", cache))
-		return false;
-	if(!ReadGlobalDefines("xml\\GlobalDefines_advc.xml", cache))
-		return false; // </advc.009>
-
-	// BETTER_BTS_AI_MOD, XML Options, 02/21/10, jdog5000: START
-	ReadGlobalDefines("xml\\BBAI_Game_Options_GlobalDefines.xml", cache);
-	// advc.104x: Removed the BBAI prefix from the file name
-	ReadGlobalDefines("xml\\AI_Variables_GlobalDefines.xml", cache);
-	ReadGlobalDefines("xml\\TechDiffusion_GlobalDefines.xml", cache);
-	ReadGlobalDefines("xml\\LeadFromBehind_GlobalDefines.xml", cache);
-	// BETTER_BTS_AI_MOD: END
-
+	/*	advc.opt: File lists moved up so that the binary cache can check them.
+		The first iREQUIRED_FILES need to be loaded successfully. */
+	char const* const aszFiles[] = {
+		"xml\\GlobalDefines.xml",
+		"xml\\GlobalDefinesAlt.xml",
+		"xml\\PythonCallbackDefines.xml",
+		// <advc.009> Load additional GlobalDefines files
+		"xml\\GlobalDefines_devel.xml",
+		"xml\\GlobalDefines_advc.xml", // </advc.009>
+		// BETTER_BTS_AI_MOD, XML Options, 02/21/10, jdog5000: START
+		"xml\\BBAI_Game_Options_GlobalDefines.xml",
+		// advc.104x: Removed the BBAI prefix from the file name
+		"xml\\AI_Variables_GlobalDefines.xml",
+		"xml\\TechDiffusion_GlobalDefines.xml",
+		"xml\\LeadFromBehind_GlobalDefines.xml",
+		// BETTER_BTS_AI_MOD: END
+	};
+	int const iREQUIRED_FILES = 5;
+	std::vector<CvString> aszModuleFiles;
 	if (gDLL->isModularXMLLoading())
 	{
-		std::vector<CvString> aszFiles;
-		gDLL->enumerateFiles(aszFiles, "modules\\*_GlobalDefines.xml");
-		for (std::vector<CvString>::iterator it = aszFiles.begin(); it != aszFiles.end(); ++it)
+		gDLL->enumerateFiles(aszModuleFiles, "modules\\*_GlobalDefines.xml");
+		std::vector<CvString> aszModularFiles;
+		gDLL->enumerateFiles(aszModularFiles, "modules\\*_PythonCallbackDefines.xml");
+		aszModuleFiles.insert(aszModuleFiles.end(),
+				aszModularFiles.begin(), aszModularFiles.end());
+	}
+	// <advc.opt>
+	XMLBinaryCache binaryCache("GlobalDefines");
+	for (int i = 0; i < ARRAY_LENGTH(aszFiles); i++)
+	{
+		if (!binaryCache.addSourceFile(aszFiles[i]))
+			logMsg("Can't check %s; GlobalDefines binary cache disabled", aszFiles[i]);
+	}
+	for (size_t i = 0; i < aszModuleFiles.size(); i++)
+	{
+		if (!binaryCache.addSourceFile(aszModuleFiles[i]))
+		{
+			logMsg("Can't check %s; GlobalDefines binary cache disabled",
+					aszModuleFiles[i].c_str());
+		}
+	}
+	if (binaryCache.readGlobalDefines(*GC.getDefinesVarSystem()))
+		logMsg("Read GlobalDefines from binary cache");
+	else // </advc.opt>
+	{
+		for (int i = 0; i < ARRAY_LENGTH(aszFiles); i++)
 		{
-			if (!ReadGlobalDefines(*it, cache))
+			if (!ReadGlobalDefines(aszFiles[i], cache) && i < iREQUIRED_FILES)
 				return false;
 		}
-
-		std::vector<CvString> aszModularFiles;
-		gDLL->enumerateFiles(aszModularFiles, "modules\\*_PythonCallbackDefines.xml");
-		for (std::vector<CvString>::iterator it = aszModularFiles.begin(); it != aszModularFiles.end(); ++it)
+		for (size_t i = 0; i < aszModuleFiles.size(); i++)
 		{
-			if (!ReadGlobalDefines(*it, cache))
+			if (!ReadGlobalDefines(aszModuleFiles[i], cache))
 				return false;
 		}
+		binaryCache.writeGlobalDefines(*GC.getDefinesVarSystem()); // advc.opt
 	}
 	#if ENABLE_XML_FILE_CACHE
 	gDLL->destroyCache(cache);
@@ -501,6 +523,48 @@ bool CvXMLLoadUtility::LoadGlobalText()
 
 	gDLL->enumerateFiles(aszFiles, "xml\\text\\*.xml");
 
+	/*	K-Mod: Remove duplicate files. (Both will be loaded from the mod folder anyway,
+		so this will save us some time.)
+		However, we must not disturb the order of the list, because it is
+		important that the modded files overrule the unmodded files. */
+	for(std::vector<CvString>::iterator it = aszFiles.begin(); it != aszFiles.end(); ++it)
+	{
+		std::vector<CvString>::iterator jt = it+1;
+		while (jt != aszFiles.end())
+		{
+			if (it->CompareNoCase(*jt) == 0)
+				jt = aszFiles.erase(jt);
+			else
+				++jt;
+		}
+	}
+	// K-Mod end
+
+	if (gDLL->isModularXMLLoading())
+	{
+		gDLL->enumerateFiles(aszModfiles, "modules\\*_CIV4GameText.xml");
+		aszFiles.insert(aszFiles.end(), aszModfiles.begin(), aszModfiles.end());
+	}
+	// <advc.opt>
+	int const iCurrentLanguage = GAMETEXT.getCurrentLanguage();
+	XMLBinaryCache binaryCache(CvString::format("GameText%d", iCurrentLanguage).c_str());
+	binaryCache.addKey(iCurrentLanguage);
+	for (size_t i = 0; i < aszFiles.size(); i++)
+	{
+		if (!binaryCache.addSourceFile(aszFiles[i]))
+			logMsg("Can't check %s; GameText binary cache disabled", aszFiles[i].c_str());
+	}
+	{
+		int iNumLanguages=0;
+		if (binaryCache.readGameText(iNumLanguages))
+		{
+			logMsg("Read GameText from binary cache");
+			CvGameText dummy;
+			dummy.setNumLanguages(iNumLanguages);
+			DestroyFXml();
+			return true;
+		}
+	} // </advc.opt>
 	/*	K-Mod. Text files from mods may not have the same set of languages
 		as the base game. When such a mismatch occurs, we cannot simply rely
 		on "getCurrentLanguage()" to give us the correct text from the mod file.
@@ -512,7 +576,8 @@ bool CvXMLLoadUtility::LoadGlobalText()
 		that particular text file is well formed, and I'm going to use it
 		to determine the current language name.
 		(Note: I'd like to use the names from TXT_KEY_LANGUAGE_#,
-		but that text isn't easy to access.) */
+		but that text isn't easy to access.)
+		(advc.opt: Moved below the binary cache check) */
 	/*	label text for the currently selected language --
 		that should correspond to the xml label used for that language. */
 	std::string langauge_name;
@@ -550,30 +615,7 @@ bool CvXMLLoadUtility::LoadGlobalText()
 			CvGameText dummy;
 			dummy.setNumLanguages(i);
 		}
-	}
-
-	/*	Remove duplicate files. (Both will be loaded from the mod folder anyway,
-		so this will save us some time.)
-		However, we must not disturb the order of the list, because it is
-		important that the modded files overrule the unmodded files. */
-	for(std::vector<CvString>::iterator it = aszFiles.begin(); it != aszFiles.end(); ++it)
-	{
-		std::vector<CvString>::iterator jt = it+1;
-		while (jt != aszFiles.end())
-		{
-			if (it->CompareNoCase(*jt) == 0)
-				jt = aszFiles.erase(jt);
-			else
-				++jt;
-		}
-	}
-	// K-Mod end
-
-	if (gDLL->isModularXMLLoading())
-	{
-		gDLL->enumerateFiles(aszModfiles, "modules\\*_CIV4GameText.xml");
-		aszFiles.insert(aszFiles.end(), aszModfiles.begin(), aszModfiles.end());
-	}
+	} // K-Mod end
 
 	for(std::vector<CvString>::iterator it = aszFiles.begin(); it != aszFiles.end(); ++it)
 	{
@@ -588,11 +630,13 @@ bool CvXMLLoadUtility::LoadGlobalText()
 		if (bLoaded)
 		{
 			// if the xml is successfully validated
-			SetGameText("Civ4GameText", "Civ4GameText/TEXT", langauge_name);
+			SetGameText("Civ4GameText", "Civ4GameText/TEXT", langauge_name,
+					&binaryCache); // advc.opt
 		}
 	}
 
 	DestroyFXml();
+	binaryCache.writeGameText(CvGameText().getNumLanguages()); // advc.opt
 
 	#if ENABLE_XML_FILE_CACHE
 		// write global text info to cache
@@ -1160,7 +1204,8 @@ void CvXMLLoadUtility::SetGlobalAnimationPathInfo(CvAnimationPathInfo** ppAnimat
 
 
 // Reads game text info from XML and adds it to the translation manager
-void CvXMLLoadUtility::SetGameText(const char* szTextGroup, const char* szTagName, const std::string& language_name)
+void CvXMLLoadUtility::SetGameText(const char* szTextGroup, const char* szTagName, const std::string& language_name,
+	XMLBinaryCache* pCache) // advc.opt
 {
 	PROFILE_FUNC();
 	logMsg("SetGameText %s\n", szTagName);
@@ -1178,6 +1223,12 @@ void CvXMLLoadUtility::SetGameText(const char* szTextGroup, const char* szTagNam
 			textInfo.read(this, language_name); // K-Mod
 
 			gDLL->addText(textInfo.getType() /*id*/, textInfo.getText(), textInfo.getGender(), textInfo.getPlural());
+			// <advc.opt>
+			if (pCache != NULL)
+			{
+				pCache->recordText(textInfo.getType(), textInfo.getText(),
+						textInfo.getGender(), textInfo.getPlural());
+			} // </advc.opt>
 			if (!gDLL->getXMLIFace()->NextSibling(m_pFXml) && i!=iNumVals-1)
 			{
 				char	szMessage[1024];
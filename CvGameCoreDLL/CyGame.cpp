@@ -8,6 +8,7 @@
 #include "CyPlayer.h"
 #include "CyDeal.h"
 #include "CyReplayInfo.h"
+#include "AutoPlayBenchmark.h" // advc.003o
 
 void CyGame::updateScore(bool bForce)
 {
@@ -496,6 +497,11 @@ void CyGame::setAIAutoPlay(int iNewValue)
 {
 	m_kGame.setAIAutoPlay(iNewValue);
 }
+// advc.003o:
+void CyGame::startAutoPlayBenchmark(int iTurns, int iSeed)
+{
+	AutoPlayBenchmark::start(iTurns, iSeed);
+}
 
 // K-Mod, 11/dec/10, start
 int CyGame::getGlobalWarmingIndex() const
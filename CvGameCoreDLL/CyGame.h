@@ -138,6 +138,7 @@ public:
 
 	int getAIAutoPlay() const;
 	void setAIAutoPlay(int iNewValue);
+	void startAutoPlayBenchmark(int iTurns, int iSeed); // advc.003o
 
 	int getGlobalWarmingIndex() const;	// K-Mod
 	int getGlobalWarmingChances() const;	// K-Mod
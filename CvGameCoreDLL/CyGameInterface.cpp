@@ -131,6 +131,7 @@ void CyGamePythonInterface()
 
 		.def("getAIAutoPlay", &CyGame::getAIAutoPlay)
 		.def("setAIAutoPlay", &CyGame::setAIAutoPlay)
+		.def("startAutoPlayBenchmark", &CyGame::startAutoPlayBenchmark, "void (int iTurns, int iSeed) - advc.003o: AI Auto Play with timings written to Logs/AutoPlayBenchmark.csv; iSeed < 0 keeps the seed")
 
 		.def("getGlobalWarmingIndex", &CyGame::getGlobalWarmingIndex)	// K-Mod
 		.def("getGlobalWarmingChances", &CyGame::getGlobalWarmingChances)	// K-Mod
@@ -175,6 +175,18 @@ void IFPBegin(void)
 	}
 }
 
+// <advc.003o>
+int IFPNumSamples()
+{
+	return numSamples;
+}
+
+ProfileSample const* IFPGetSample(int iId)
+{
+	FAssertBounds(0, numSamples, iId);
+	return sampleList[iId];
+} // </advc.003o>
+
 void IFPEnd(void)
 {
 	//	Log the timings
@@ -19,6 +19,9 @@ void IFPBeginSample(ProfileSample* sample);
 void IFPEndSample(ProfileSample* sample);
 void dumpProfileStack(void);
 void EnableDetailedTrace(bool enable);
+// advc.003o: For AutoPlayBenchmark
+int IFPNumSamples();
+ProfileSample const* IFPGetSample(int iId);
 #endif // </advc.003o>
 
 
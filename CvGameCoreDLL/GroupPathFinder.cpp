@@ -782,6 +782,13 @@ void GroupPathFinder::invalidateGroup(CvSelectionGroup const& kGroup)
 	}
 }
 
+// advc.opt:
+void GroupPathFinder::rebindGroup(CvSelectionGroup const& kGroup)
+{
+	m_stepMetric = GroupStepMetric(&kGroup, m_stepMetric.getFlags(),
+			m_stepMetric.getMaxPath(), m_stepMetric.getHeuristicWeight());
+}
+
 
 bool GroupPathFinder::generatePath(CvPlot const& kTo)
 {
@@ -809,6 +816,232 @@ CvPlot& GroupPathFinder::getPathEndTurnPlot() const
 	#endif // </advc.test>
 }
 
+// <advc.opt>
+int GroupPathCache::m_iEpoch = 0;
+int GroupPathCache::m_iProfileStamp = 0;
+
+GroupPathCache::GroupPathCache()
+:	m_iLastEntry(-1), m_iUseCounter(0), m_bMovePromotionsSet(false),
+	m_iStaticProfilesStamp(-1)
+{
+	m_aEntries.resize(NUM_ENTRIES);
+	for (size_t i = 0; i < m_aEntries.size(); i++)
+	{
+		Entry& kEntry = m_aEntries[i];
+		kEntry.pFinder = new GroupPathFinder();
+		kEntry.iEpoch = -1;
+		kEntry.iDangerEpoch = -1;
+		kEntry.iLastUse = -1;
+	}
+}
+
+
+GroupPathCache::~GroupPathCache()
+{
+	for (size_t i = 0; i < m_aEntries.size(); i++)
+		SAFE_DELETE(m_aEntries[i].pFinder);
+}
+
+
+GroupPathFinder* GroupPathCache::lookup(CvSelectionGroup const& kGroup,
+	MovementFlags eFlags)
+{
+	PROFILE_FUNC();
+	#ifdef VERIFY_PATHF // advc.test: The legacy pathfinder can't take over nodes
+	return NULL;
+	#endif
+	if (!getProfile(kGroup, eFlags, m_aiProfile))
+		return NULL;
+	m_iUseCounter++;
+	int iMatch = -1;
+	// Usually, the same group asks repeatedly
+	if (m_iLastEntry >= 0 && m_aEntries[m_iLastEntry].aiProfile == m_aiProfile)
+		iMatch = m_iLastEntry;
+	else
+	{
+		for (int i = 0; i < (int)m_aEntries.size(); i++)
+		{
+			if (m_aEntries[i].aiProfile == m_aiProfile)
+			{
+				iMatch = i;
+				break;
+			}
+		}
+	}
+	if (iMatch >= 0)
+	{
+		Entry& kEntry = m_aEntries[iMatch];
+		CvSelectionGroup const* pOldGroup = kEntry.pFinder->getGroup();
+		bool bValid = isCurrent(kEntry);
+		/*	The nodes may have been computed since through
+			CvSelectionGroup::pathFinder for some group that no longer matches */
+		if (bValid && pOldGroup != NULL && pOldGroup != &kGroup)
+		{
+			std::vector<int> aiOldProfile;
+			bValid = (getProfile(*pOldGroup, eFlags, aiOldProfile) &&
+					aiOldProfile == kEntry.aiProfile);
+		}
+		if (!bValid)
+			kEntry.pFinder->reset();
+		if (pOldGroup != &kGroup)
+			kEntry.pFinder->rebindGroup(kGroup);
+		setCurrent(kEntry);
+		m_iLastEntry = iMatch;
+		return kEntry.pFinder;
+	}
+	int iOldest = 0;
+	for (int i = 1; i < (int)m_aEntries.size(); i++)
+	{
+		if (m_aEntries[i].iLastUse < m_aEntries[iOldest].iLastUse)
+			iOldest = i;
+	}
+	Entry& kEntry = m_aEntries[iOldest];
+	kEntry.pFinder->reset();
+	kEntry.pFinder->rebindGroup(kGroup);
+	kEntry.aiProfile.swap(m_aiProfile);
+	setCurrent(kEntry);
+	m_iLastEntry = iOldest;
+	return kEntry.pFinder;
+}
+
+
+void GroupPathCache::invalidateGroup(CvSelectionGroup const& kGroup)
+{
+	for (size_t i = 0; i < m_aEntries.size(); i++)
+		m_aEntries[i].pFinder->invalidateGroup(kGroup);
+}
+
+
+bool GroupPathCache::isCurrent(Entry const& kEntry) const
+{
+	return (kEntry.iEpoch == m_iEpoch &&
+			kEntry.iDangerEpoch == CvPlayerAI::AI_getDangerCacheEpoch());
+}
+
+
+void GroupPathCache::setCurrent(Entry& kEntry)
+{
+	kEntry.iEpoch = m_iEpoch;
+	kEntry.iDangerEpoch = CvPlayerAI::AI_getDangerCacheEpoch();
+	kEntry.iLastUse = m_iUseCounter;
+}
+
+/*	Everything about kGroup that GroupStepMetric looks at, apart from the
+	plots. False if kGroup shouldn't share its paths. */
+bool GroupPathCache::getProfile(CvSelectionGroup const& kGroup, MovementFlags eFlags,
+	std::vector<int>& aiProfile)
+{
+	aiProfile.clear();
+	/*	Attack stacks compare their strength (i.e. hit points) with the enemy;
+		cargo and amphibious moves depend on the units being transported. */
+	if (!kGroup.AI_isControlled() || (eFlags & MOVE_ATTACK_STACK) ||
+		kGroup.getNumUnits() <= 0)
+	{
+		return false;
+	}
+	std::vector<int> const& aiStaticProfile = getStaticProfile(kGroup);
+	aiProfile.insert(aiProfile.end(), aiStaticProfile.begin(), aiStaticProfile.end());
+	// Same as in GroupPathFinder::setGroup
+	MovementFlags const eRelevantFlags =
+			~(MOVE_DIRECT_ATTACK | MOVE_SINGLE_ATTACK | MOVE_NO_ATTACK);
+	aiProfile.push_back(GC.getMap().plotNum(kGroup.getPlot()));
+	aiProfile.push_back(eFlags & eRelevantFlags);
+	aiProfile.push_back(kGroup.getHeadUnitAIType());
+	aiProfile.push_back(kGroup.AI().AI_getMissionAIType());
+	aiProfile.push_back(kGroup.getAutomateType());
+	FOR_EACH_UNIT_IN(pUnit, kGroup)
+	{
+		if (pUnit->isCargo() || pUnit->hasCargo())
+			return false;
+		aiProfile.push_back(pUnit->movesLeft());
+		aiProfile.push_back(pUnit->maxMoves());
+		aiProfile.push_back((pUnit->isMadeAttack() ? 1 : 0) |
+				(pUnit->isMadeAllAttacks() ? 2 : 0));
+	}
+	return true;
+}
+
+/*	The owner, unit types and movement-related promotions of kGroup's units.
+	Reused until the next group update unless units join or leave kGroup. */
+std::vector<int> const& GroupPathCache::getStaticProfile(CvSelectionGroup const& kGroup)
+{
+	if (m_iStaticProfilesStamp != m_iProfileStamp)
+	{
+		m_staticProfiles.clear();
+		m_iStaticProfilesStamp = m_iProfileStamp;
+	}
+	StaticProfile& kProfile = m_staticProfiles[
+			std::make_pair((int)kGroup.getOwner(), kGroup.getID())];
+	bool bValid = ((int)kProfile.aiUnitIDs.size() == kGroup.getNumUnits());
+	if (bValid)
+	{
+		int iUnit = 0;
+		FOR_EACH_UNIT_IN(pUnit, kGroup)
+		{
+			if (kProfile.aiUnitIDs[iUnit] != pUnit->getID())
+			{
+				bValid = false;
+				break;
+			}
+			iUnit++;
+		}
+	}
+	if (bValid)
+		return kProfile.aiProfile;
+	if (!m_bMovePromotionsSet)
+		setMovePromotions();
+	kProfile.aiUnitIDs.clear();
+	std::vector<int>& aiProfile = kProfile.aiProfile;
+	aiProfile.clear();
+	aiProfile.push_back(kGroup.getOwner());
+	aiProfile.push_back(kGroup.getNumUnits());
+	FOR_EACH_UNIT_IN(pUnit, kGroup)
+	{
+		kProfile.aiUnitIDs.push_back(pUnit->getID());
+		aiProfile.push_back(pUnit->getUnitType());
+		int iPromotionBits = 0;
+		for (size_t i = 0; i < m_aeMovePromotions.size(); i++)
+		{
+			if (pUnit->isHasPromotion(m_aeMovePromotions[i]))
+				iPromotionBits |= (1 << (i % 32));
+			if (i % 32 == 31)
+			{
+				aiProfile.push_back(iPromotionBits);
+				iPromotionBits = 0;
+			}
+		}
+		aiProfile.push_back(iPromotionBits);
+	}
+	return aiProfile;
+}
+
+
+void GroupPathCache::setMovePromotions()
+{
+	m_aeMovePromotions.clear();
+	FOR_EACH_ENUM(Promotion)
+	{
+		CvPromotionInfo const& kPromo = GC.getInfo(eLoopPromotion);
+		bool bMove = (kPromo.getMovesChange() != 0 ||
+				kPromo.getMoveDiscountChange() != 0 || kPromo.isAmphib() ||
+				kPromo.isRiver() || kPromo.isEnemyRoute() ||
+				kPromo.isHillsDoubleMove());
+		FOR_EACH_ENUM(Terrain)
+		{
+			if (kPromo.getTerrainDoubleMove(eLoopTerrain))
+				bMove = true;
+		}
+		FOR_EACH_ENUM(Feature)
+		{
+			if (kPromo.getFeatureDoubleMove(eLoopFeature))
+				bMove = true;
+		}
+		if (bMove)
+			m_aeMovePromotions.push_back(eLoopPromotion);
+	}
+	m_bMovePromotionsSet = true;
+} // </advc.opt>
+
 // <advc.test>
 #ifdef VERIFY_PATHF
 bool GroupPathFinder::generatePath(CvPlot const& kFrom, CvPlot const& kTo)
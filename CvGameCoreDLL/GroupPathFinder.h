@@ -42,6 +42,9 @@ class CvSelectionGroup;
 class GroupStepMetric : public StepMetricBase<GroupPathNode>
 {
 public:
+	/*	advc.opt: Long AI war paths on large maps make the open list grow into
+		the hundreds. (Replace with PathOpenListVector for comparison.) */
+	typedef PathOpenListHeap<GroupPathNode> OpenList;
 /*	static interface so that GroupStepMetric can share code with the
 	FAStar pathfinder in the EXE */
 	static bool isValidStep(CvPlot const& kFrom, CvPlot const& kTo,
@@ -141,6 +144,13 @@ public:
 	inline int getPathTurns() const { return getPathLength(); }
 	__forceinline void reset() { resetNodes(); }
 	#endif // advc.test
+	/*	advc.opt: Let kGroup take over the nodes computed for the current group.
+		Only for GroupPathCache, which ensures that the groups are equivalent. */
+	void rebindGroup(CvSelectionGroup const& kGroup);
+	inline CvSelectionGroup const* getGroup() const
+	{
+		return m_stepMetric.getGroup();
+	}
 	CvPlot& getPathEndTurnPlot() const;
 	int getFinalMoves() const
 	{
@@ -185,4 +195,70 @@ private:
 	#endif // <advc.test>
 };
 
+/*	advc.opt: Pathfinders shared by AI groups with the same movement profile,
+	i.e. same owner, location, (relevant) movement flags, unit AI and mission AI
+	type of the head unit, and the same sequence of unit types with the same
+	moves, attack status and movement-related promotions. For such groups,
+	GroupStepMetric computes the same costs and the same step validity, so a
+	group can continue the search of another group instead of starting over.
+	An entry gets discarded when GroupPathCache::invalidate or either variant
+	of CvPlayerAI::AI_invalidateDangerCache has been called since it was
+	filled. That covers the terrain, route, border, war and team changes that
+	the step metric depends on, the start of each player's turn and also every
+	unit move, unit death and visibility change - the step metric reads the
+	danger counts and the visible units. So only groups updated with no such
+	change in between share their searches. The parts of a group's profile
+	that can't change while the group gets updated are computed only once per
+	group update. Only AI-controlled groups that don't attack stacks and don't
+	involve cargo take part. Not serialized. */
+class GroupPathCache : private boost::noncopyable
+{
+public:
+	GroupPathCache();
+	~GroupPathCache();
+	/*	Pathfinder bound to kGroup whose nodes are valid for kGroup; the caller
+		still needs to call setGroup. NULL if kGroup is not eligible. */
+	GroupPathFinder* lookup(CvSelectionGroup const& kGroup, MovementFlags eFlags);
+	void invalidateGroup(CvSelectionGroup const& kGroup);
+	static inline void invalidate() { m_iEpoch++; }
+	// Start of a group update or a promotion
+	static inline void invalidateProfiles() { m_iProfileStamp++; }
+
+private:
+	enum { NUM_ENTRIES = 8 };
+	struct Entry
+	{
+		GroupPathFinder* pFinder;
+		std::vector<int> aiProfile;
+		int iEpoch;
+		int iDangerEpoch;
+		int iLastUse;
+	};
+	std::vector<Entry> m_aEntries;
+	std::vector<int> m_aiProfile; // buffer
+	int m_iLastEntry;
+	int m_iUseCounter;
+	// Promotions that can affect movement costs; computed on first use.
+	std::vector<PromotionTypes> m_aeMovePromotions;
+	bool m_bMovePromotionsSet;
+	static int m_iEpoch;
+	/*	Profile parts that only change through promotions, keyed by
+		(owner, group id). Cleared when m_iProfileStamp changes. */
+	struct StaticProfile
+	{
+		std::vector<int> aiUnitIDs;
+		std::vector<int> aiProfile;
+	};
+	std::map<std::pair<int,int>,StaticProfile> m_staticProfiles;
+	int m_iStaticProfilesStamp;
+	static int m_iProfileStamp;
+
+	bool isCurrent(Entry const& kEntry) const;
+	void setCurrent(Entry& kEntry);
+	bool getProfile(CvSelectionGroup const& kGroup, MovementFlags eFlags,
+			std::vector<int>& aiProfile);
+	std::vector<int> const& getStaticProfile(CvSelectionGroup const& kGroup);
+	void setMovePromotions();
+};
+
 #endif
@@ -57,9 +57,30 @@ public:
 	{
 		m_iPathLength = iPathLength;
 	}
+	// advc.opt: Bookkeeping for PathOpenListHeap; meaningless while not open.
+	__forceinline int getOpenListPos() const
+	{
+		return m_iOpenListPos;
+	}
+	__forceinline void setOpenListPos(int iPos)
+	{
+		m_iOpenListPos = iPos;
+	}
+	__forceinline int getOpenSeq() const
+	{
+		return m_iOpenSeq;
+	}
+	__forceinline void setOpenSeq(int iSeq)
+	{
+		m_iOpenSeq = iSeq;
+	}
 protected:
 	CvPlot* m_pPlot; // FAStarNode::m_iX, m_iY in K-MMod
 	int m_iPathLength; // FAStarNode::m_iData2 in K-Mod
+	// <advc.opt>
+	int m_iOpenListPos; // Index in the heap array of PathOpenListHeap
+	int m_iOpenSeq; // Order of insertion into the open list (for tie-breaking)
+	// </advc.opt>
 public: // Keeping these public (for now) for interchangeability with FAStarNode
 	int m_iTotalCost;
 	int m_iKnownCost;
@@ -82,6 +103,265 @@ private: // (Derived classes probably shouldn't access this)
 
 class PathNode : public PathNodeBase<PathNode> {};
 
+/*	advc.opt: Open list policies for KmodPathFinder. A step metric selects one
+	through an OpenList typedef (see StepMetricBase). Both classes are
+	responsible for keeping PathNodeState data up to date, and both pick the same
+	node on each processNode call: the open node with the lowest total cost among
+	those whose path length doesn't exceed the max path length, and, in case of
+	a tie, the one that was opened first. So the policies only differ in speed;
+	switching between them shouldn't change any paths (in particular not the
+	results checked by VERIFY_PATHF). */
+
+/*	Unsorted vector; the best node is found through a linear scan.
+	(This used to be the only open list implementation - KmodPathFinder::OpenList.) */
+template<class Node>
+class PathOpenListVector
+{
+public:
+	typedef std::vector<Node*> container_t;
+	typedef typename container_t::iterator iterator;
+	typedef typename container_t::const_iterator const_iterator;
+	PathOpenListVector() : m_iMaxPath(MAX_INT) {}
+	inline const_iterator begin() const
+	{
+		return m_nodes.begin();
+	}
+	inline const_iterator end() const
+	{
+		return m_nodes.end();
+	}
+	inline iterator begin()
+	{
+		return m_nodes.begin();
+	}
+	inline iterator end()
+	{
+		return m_nodes.end();
+	}
+	inline void reserve(int iCapacity)
+	{
+		m_nodes.reserve(iCapacity);
+	}
+	inline void clear() // Does not change the state of any nodes
+	{
+		/*	This erases every element. So does resize(0).
+			The only way to avoid this, I think, would be to use a raw array
+			instead of a vector. */
+		m_nodes.clear();
+	}
+	/*	Nodes with a path length greater than iMaxPath are ineligible for
+		closeBest (but remain open). */
+	inline void setMaxPath(int iMaxPath)
+	{
+		m_iMaxPath = iMaxPath;
+	}
+	// These functions do change the state of nodes (hence the names) ...
+	inline void open(Node& kNode)
+	{
+		m_nodes.push_back(&kNode);
+		// Inefficient to add the same node multiple times
+		//FAssert(!kNode.isState(PATHNODE_OPEN)); // (Seems to work; can stop checking.)
+		kNode.setState(PATHNODE_OPEN);
+	}
+	/*	Closes and returns the best eligible node if its total cost is
+		less than iCostBound. Otherwise returns NULL. */
+	Node* closeBest(int iCostBound)
+	{
+		iterator itBest = m_nodes.end();
+		int iLowestCost = iCostBound;
+		for (iterator it = m_nodes.begin(); it != m_nodes.end(); ++it)
+		{
+			Node const& kNode = **it;
+			if (kNode.m_iTotalCost < iLowestCost &&
+				kNode.getPathLength() <= m_iMaxPath)
+			{
+				itBest = it;
+				iLowestCost = kNode.m_iTotalCost;
+			}
+		}
+		if (itBest == m_nodes.end())
+			return NULL;
+		Node& kBest = **itBest;
+		FAssert(kBest.isState(PATHNODE_OPEN));
+		kBest.setState(PATHNODE_CLOSED);
+		/*	Expensive on a vector, but faster iteration more than makes up for it
+			in comparison with a list. A deque performs much better than a list, but
+			still worse than the vector. I've also tried replacing closed nodes with
+			a blank dummy node (not NULL b/c that would require an additional check
+			in KmodPathFinder::processNode), and cleaning out blank nodes
+			periodically. At least with 18 civs, this was slightly slower than
+			vector::erase, all in all. */
+		m_nodes.erase(itBest);
+		return &kBest;
+	}
+	// The linear scan always sees the current costs; nothing to do.
+	inline void updateKey(Node& kNode) {}
+	inline void rebuild() {}
+private:
+	container_t m_nodes;
+	int m_iMaxPath;
+};
+
+/*	Binary min-heap with decrease-key (and increase-key - forwardPropagate can
+	also raise costs). Each node stores its heap position. Nodes within the
+	max path length have absolute priority over those beyond it, which makes
+	the eligibility check in closeBest a matter of looking at the root.
+	K-Mod had apparently tried std::priority_queue, which lacks the
+	key updates; see comment in KmodPathFinder. */
+template<class Node>
+class PathOpenListHeap
+{
+public:
+	typedef std::vector<Node*> container_t;
+	typedef typename container_t::iterator iterator;
+	typedef typename container_t::const_iterator const_iterator;
+	PathOpenListHeap() : m_iMaxPath(MAX_INT), m_iNextSeq(0) {}
+	/*	Iteration is in heap order. Callers that change the total cost of
+		the nodes while iterating need to call rebuild afterwards. */
+	inline const_iterator begin() const
+	{
+		return m_nodes.begin();
+	}
+	inline const_iterator end() const
+	{
+		return m_nodes.end();
+	}
+	inline iterator begin()
+	{
+		return m_nodes.begin();
+	}
+	inline iterator end()
+	{
+		return m_nodes.end();
+	}
+	inline void reserve(int iCapacity)
+	{
+		m_nodes.reserve(iCapacity);
+	}
+	inline void clear() // Does not change the state of any nodes
+	{
+		m_nodes.clear();
+		m_iNextSeq = 0;
+	}
+	inline void setMaxPath(int iMaxPath)
+	{
+		if (iMaxPath != m_iMaxPath)
+		{
+			m_iMaxPath = iMaxPath;
+			rebuild();
+		}
+	}
+	void open(Node& kNode)
+	{
+		kNode.setState(PATHNODE_OPEN);
+		kNode.setOpenSeq(m_iNextSeq);
+		m_iNextSeq++;
+		m_nodes.push_back(&kNode);
+		int const iPos = size() - 1;
+		kNode.setOpenListPos(iPos);
+		siftUp(iPos);
+	}
+	Node* closeBest(int iCostBound)
+	{
+		if (m_nodes.empty())
+			return NULL;
+		Node& kBest = *m_nodes[0];
+		if (kBest.m_iTotalCost >= iCostBound || kBest.getPathLength() > m_iMaxPath)
+			return NULL;
+		FAssert(kBest.isState(PATHNODE_OPEN));
+		kBest.setState(PATHNODE_CLOSED);
+		Node* pLast = m_nodes.back();
+		m_nodes.pop_back();
+		if (pLast != &kBest)
+		{
+			m_nodes[0] = pLast;
+			pLast->setOpenListPos(0);
+			siftDown(0);
+		}
+		return &kBest;
+	}
+	/*	To be called after changing the total cost or path length of kNode.
+		Does nothing if kNode isn't open. */
+	void updateKey(Node& kNode)
+	{
+		if (!kNode.isState(PATHNODE_OPEN))
+			return;
+		int const iPos = kNode.getOpenListPos();
+		FAssert(m_nodes[iPos] == &kNode);
+		if (!siftUp(iPos))
+			siftDown(iPos);
+	}
+	// Restores the heap property after arbitrary changes to the keys
+	void rebuild()
+	{
+		for (int iPos = size() / 2 - 1; iPos >= 0; iPos--)
+			siftDown(iPos);
+	}
+private:
+	container_t m_nodes;
+	int m_iMaxPath;
+	int m_iNextSeq;
+
+	inline int size() const
+	{
+		return static_cast<int>(m_nodes.size());
+	}
+	// Strict weak ordering that mimics the selection in PathOpenListVector
+	inline bool isBetter(Node const& kFirst, Node const& kSecond) const
+	{
+		bool const bFirstEligible = (kFirst.getPathLength() <= m_iMaxPath);
+		bool const bSecondEligible = (kSecond.getPathLength() <= m_iMaxPath);
+		if (bFirstEligible != bSecondEligible)
+			return bFirstEligible;
+		if (kFirst.m_iTotalCost != kSecond.m_iTotalCost)
+			return (kFirst.m_iTotalCost < kSecond.m_iTotalCost);
+		return (kFirst.getOpenSeq() < kSecond.getOpenSeq());
+	}
+	// Returns true if the node at iPos has been moved
+	bool siftUp(int iPos)
+	{
+		Node* pNode = m_nodes[iPos];
+		int const iStartPos = iPos;
+		while (iPos > 0)
+		{
+			int const iParentPos = (iPos - 1) / 2;
+			Node* pParent = m_nodes[iParentPos];
+			if (!isBetter(*pNode, *pParent))
+				break;
+			m_nodes[iPos] = pParent;
+			pParent->setOpenListPos(iPos);
+			iPos = iParentPos;
+		}
+		m_nodes[iPos] = pNode;
+		pNode->setOpenListPos(iPos);
+		return (iPos != iStartPos);
+	}
+	void siftDown(int iPos)
+	{
+		int const iSize = size();
+		Node* pNode = m_nodes[iPos];
+		while (true)
+		{
+			int iChildPos = 2 * iPos + 1;
+			if (iChildPos >= iSize)
+				break;
+			if (iChildPos + 1 < iSize &&
+				isBetter(*m_nodes[iChildPos + 1], *m_nodes[iChildPos]))
+			{
+				iChildPos++;
+			}
+			Node* pChild = m_nodes[iChildPos];
+			if (!isBetter(*pChild, *pNode))
+				break;
+			m_nodes[iPos] = pChild;
+			pChild->setOpenListPos(iPos);
+			iPos = iChildPos;
+		}
+		m_nodes[iPos] = pNode;
+		pNode->setOpenListPos(iPos);
+	}
+};
+
 /*	Combines the CvPathSettings class in K-Mod with the FAStarFunc declarations
 	originally in CvGameCoreUtils.h.
 	(One could regard invalid steps as having infinite cost,
@@ -103,6 +383,9 @@ public:
 	/*	If this function is replaced, then initializePathData should be replaced
 		as well. */
 	inline int initialPathLength() const { return 1; }
+	/*	advc.opt: Open list policy used by KmodPathFinder. Derived classes can
+		shadow this typedef, e.g. with PathOpenListHeap<Node>. */
+	typedef PathOpenListVector<Node> OpenList;
 protected:
 	/*	Derived classes have to have a 0-argument constructor that will get called
 		when KmodPathFinder is instantiated. */
@@ -210,68 +493,9 @@ class KmodPathFinder
 {
 protected:
 
-	/*	Replaces
-		typedef std::vector<Node*> OpenList;
-		Apart from encapsulating the STL container, this class is responsible
-		for keeping PathNodeState data up to date. */
-	class OpenList
-	{
-	public:
-		typedef std::vector<Node*> container_t;
-		typedef typename container_t::iterator iterator;
-		typedef typename container_t::const_iterator const_iterator;
-		inline const_iterator begin() const
-		{
-			return m_nodes.begin();
-		}
-		inline const_iterator end() const
-		{
-			return m_nodes.end();
-		}
-		inline iterator begin()
-		{
-			return m_nodes.begin();
-		}
-		inline iterator end()
-		{
-			return m_nodes.end();
-		}
-		inline void reserve(int iCapacity)
-		{
-			m_nodes.reserve(iCapacity);
-		}
-		inline void clear() // Does not change the state of any nodes
-		{
-			/*	This erases every element. So does resize(0).
-				The only way to avoid this, I think, would be to use a raw array
-				instead of a vector. */
-			m_nodes.clear();
-		}
-		// These functions do change the state of nodes (hence the names) ...
-		inline void open(Node& kNode)
-		{
-			m_nodes.push_back(&kNode);
-			// Inefficient to add the same node multiple times
-			//FAssert(!kNode.isState(PATHNODE_OPEN)); // (Seems to work; can stop checking.)
-			kNode.setState(PATHNODE_OPEN);
-		}
-		inline void close(iterator pos)
-		{
-			Node& kNode = **pos;
-			FAssert(kNode.isState(PATHNODE_OPEN));
-			kNode.setState(PATHNODE_CLOSED);
-			/*	Expensive on a vector, but faster iteration more than makes up for it
-				in comparison with a list. A deque performs much better than a list, but
-				still worse than the vector. I've also tried replacing closed nodes with
-				a blank dummy node (not NULL b/c that would require an additional check
-				in KmodPathFinder::processNode), and cleaning out blank nodes
-				periodically. At least with 18 civs, this was slightly slower than
-				vector::erase, all in all. */
-			m_nodes.erase(pos);
-		}
-	private:
-		container_t m_nodes;
-	};
+	/*	advc.opt: The open list is now a policy of the step metric;
+		see PathOpenListVector, PathOpenListHeap. */
+	typedef typename StepMetric::OpenList OpenList;
 	/*struct OpenList_sortPred {
 		bool operator()(FAStarNode const*& kpLeft, FAStarNode const*& kpRight) {
 			return (kpLeft->m_iTotalCost < kpRight->m_iTotalCost);
@@ -281,7 +505,9 @@ protected:
 		it was abandoned w/o a test. Would have to re-heap after recalculateHeuristics.
 		And the functor should take m_stepMetric.getMaxPath() as a contructor argument
 		so that nodes within that limit can receive absolute priority. But, given the
-		modest number of open nodes, I doubt that a heap will be worthwhile. */
+		modest number of open nodes, I doubt that a heap will be worthwhile.
+		advc.opt: PathOpenListHeap does all that; worthwhile at least for
+		long group paths on large maps. */
 
 	/*	Map from plots to nodes. Replacing naked array in K-Mod.
 		Historical note: Before K-Mod 1.45,
@@ -289,9 +515,12 @@ protected:
 	class NodeMap
 	{
 	public:
-		inline NodeMap(PlotNumTypes eMaxPlots) : m_eMaxPlots(eMaxPlots), m_bDirty(true)
+		inline NodeMap(PlotNumTypes eMaxPlots) : m_eMaxPlots(eMaxPlots), m_bAllDirty(true)
 		{
 			m_data = new byte[numBytes()];
+			/*	advc.opt: Most paths touch only a few hundred plots. Will grow
+				as needed and then keep its capacity. */
+			m_aeTouched.reserve(256);
 			reset();
 		}
 		inline ~NodeMap()
@@ -302,30 +531,47 @@ protected:
 		{
 			return reinterpret_cast<Node*>(m_data)[ePlot];
 		}
+		/*	advc.opt: To be called whenever a node leaves the PATHNODE_UNINITIALIZED
+			state. KmodPathFinder doesn't write to any other nodes, so only
+			these need to be cleared by reset. */
+		inline void setTouched(Node const& kNode)
+		{
+			m_aeTouched.push_back(static_cast<PlotNumTypes>(
+					&kNode - reinterpret_cast<Node const*>(m_data)));
+		}
 		void reset()
 		{
-			if (!m_bDirty)
-				return;
+			/*	advc.opt: Used to memset the whole array whenever any node had been
+				used. (And there had been a comment suggesting to keep track of
+				dirty ranges.) Clearing only the touched nodes is faster unless
+				they make up a substantial portion of the map; then a single
+				sequential memset is better. (The call counts of the two samples
+				tell how often each case occurs.) */
+			if (m_bAllDirty ||
+				static_cast<int>(m_aeTouched.size()) * FULL_RESET_RATIO >= m_eMaxPlots)
 			{
-			/*	advc: Could keep track of the smallest and highest dirty index
-				(to be updated by the get function, using branchless::min, max)
-				to save time here.
-				Or divide m_data into 4 or 8 columns with individual dirty bits.
-				There's a section "Beating memset" by Dan Higgins in the book
-				that's credited at the start of FAStarNode.h. */
 				PROFILE("NodeMap::reset - memset");
 				memset(m_data, 0, numBytes());
 			}
-			m_bDirty = false;
-		}
-		inline void setDirty(bool bDirty)
-		{
-			m_bDirty = bDirty;
+			else
+			{
+				PROFILE("NodeMap::reset - touched nodes");
+				for (size_t i = 0; i < m_aeTouched.size(); i++)
+					memset(&get(m_aeTouched[i]), 0, sizeof(Node));
+			}
+			m_aeTouched.clear();
+			m_bAllDirty = false;
 		}
 	private:
 		byte* m_data;
 		PlotNumTypes m_eMaxPlots;
-		bool m_bDirty; // advc.opt: Make sure we're not resetting unnecessarily
+		// <advc.opt>
+		std::vector<PlotNumTypes> m_aeTouched;
+		bool m_bAllDirty;
+		/*	Fall back on clearing everything when at least one in this many nodes
+			has been touched. Scattered memset calls of about the size of
+			a cache line each aren't much faster per byte than one big memset. */
+		static int const FULL_RESET_RATIO = 8; // </advc.opt>
 
 		inline int numBytes()
 		{
@@ -345,11 +591,17 @@ public:
 		m_kMap(GC.getMap()), m_pEndNode(NULL), m_pNodeMap(NULL
 		/*	advc: KmodPathFinder sometimes gets instantiated w/o ultimately getting used.
 			Therefore allocate memory as late as possible. */
-		/*new NodeMap(m_kMap.numPlots())*/)
+		/*new NodeMap(m_kMap.numPlots())*/),
+		m_iReachMapLength(-1) // advc.opt
 	{}
 	virtual ~KmodPathFinder();
 	void resetNodes();
 	bool generatePath(CvPlot const& kStart, CvPlot const& kDest);
+	/*	advc.opt: Uninformed (Dijkstra) search from kStart that processes all nodes
+		within the max path length of the step metric. Afterwards, generatePath
+		calls from kStart with at most that max path length only need to look up
+		the destination node - as long as the nodes don't get reset. */
+	void generateReachMap(CvPlot const& kStart);
 	bool isPathComplete() const { return (m_pEndNode != NULL); }
 	inline int getPathLength() const // advc: Was "getPathTurns"; too specific.
 	{
@@ -368,9 +620,13 @@ protected:
 	// <advc> Replacing (x,y) coordinates
 	CvPlot const* m_pStart;
 	CvPlot const* m_pDest; // </advc>
+	/*	advc.opt: Max path length covered by the latest generateReachMap call;
+		-1 if the nodes have been reset since. */
+	int m_iReachMapLength;
 	static int iAdmissibleBaseWeight;
 	static int iAdmissibleScaledWeight;
 
+	bool initStartNode(CvPlot const& kStart); // advc.opt
 	void recalculateHeuristics();
 	bool processNode();
 	void forwardPropagate(Node& kHead, int iCostDelta);
@@ -421,6 +677,54 @@ bool KmodPathFinder<StepMetric,Node>::generatePath(
 	if (!m_stepMetric.isValidDest(kStart, kDest))
 		return false;
 
+	// advc.opt: Start node handling moved into a subroutine
+	bool bRecalcHeuristics = initStartNode(kStart);
+	/*	<advc.opt> All nodes within the max path length have already been
+		processed; the open list can't yield anything more. Keep m_pDest
+		as it is so that the heuristic costs get recalculated when an actual
+		search becomes necessary. */
+	if (m_iReachMapLength >= m_stepMetric.getMaxPath())
+	{
+		Node& kDestNode = m_pNodeMap->get(m_kMap.plotNum(kDest));
+		if (!kDestNode.isState(PATHNODE_UNINITIALIZED))
+			m_pEndNode = &kDestNode;
+		return (m_pEndNode != NULL &&
+				m_pEndNode->getPathLength() <= m_stepMetric.getMaxPath());
+	} // </advc.opt>
+	if (m_pDest != &kDest)
+		bRecalcHeuristics = true;
+	m_pDest = &kDest;
+	{
+		Node& kDestNode = m_pNodeMap->get(m_kMap.plotNum(kDest));
+		if (!kDestNode.isState(PATHNODE_UNINITIALIZED))
+			m_pEndNode = &kDestNode;
+		/*	advc (note): If kDestNode is closed, then it could be that we've
+			been unable to move through it on a previous call, but, this time,
+			we only need to enter it, and isValidDest says that we can. */
+	}
+	// advc.opt: Max path can change w/o a reset (see GroupPathFinder::setGroup)
+	m_openList.setMaxPath(m_stepMetric.getMaxPath());
+	if (bRecalcHeuristics)
+		recalculateHeuristics();
+
+	while (processNode())
+	{
+		// nothing
+	}
+
+	if (m_pEndNode != NULL &&
+		(m_pEndNode->getPathLength() <= m_stepMetric.getMaxPath()))
+	{
+		return true;
+	}
+	return false;
+}
+
+/*	advc.opt: Cut from generatePath. Makes sure that the start node is
+	initialized and opened. Returns true if it had to be (re-)initialized. */
+template<class StepMetric, class Node>
+bool KmodPathFinder<StepMetric,Node>::initStartNode(CvPlot const& kStart)
+{
 	if (m_pNodeMap == NULL)
 	{
 		m_pNodeMap = new NodeMap(m_kMap.numPlots());
@@ -441,12 +745,8 @@ bool KmodPathFinder<StepMetric,Node>::generatePath(
 		resetNodes();
 	}
 
-	bool bRecalcHeuristics = true;
-	if (m_pDest == &kDest)
-		bRecalcHeuristics = false;
-
+	bool bNewStartNode = false;
 	m_pStart = &kStart;
-	m_pDest = &kDest;
 	{
 		Node& kStartNode = m_pNodeMap->get(m_kMap.plotNum(kStart));
 		if (!kStartNode.isState(PATHNODE_UNINITIALIZED))
@@ -461,9 +761,9 @@ bool KmodPathFinder<StepMetric,Node>::generatePath(
 				FAssert(kStartNode.isState(PATHNODE_UNINITIALIZED));
 			}
 		}
-		m_pNodeMap->setDirty(true); // advc.opt
 		if (kStartNode.isState(PATHNODE_UNINITIALIZED))
 		{
+			m_pNodeMap->setTouched(kStartNode); // advc.opt
 			// advc: Can't be helped. No CvPlot is truly const, so the cast is safe.
 			kStartNode.setPlot(*const_cast<CvPlot*>(m_pStart));
 			//pathAdd(NULL, pStartNode, ASNC_INITIALADD, &settings, NULL); // K-Mod
@@ -475,35 +775,35 @@ bool KmodPathFinder<StepMetric,Node>::generatePath(
 			kStartNode.m_bOnStack = true;*/ // (K-Mod)
 			// advc: Now handled by OpenList. See also the comment at the m_iState declaration.
 			m_openList.open(kStartNode);
-			bRecalcHeuristics = true;
+			bNewStartNode = true;
 		}
 		/*	advc (note): What if kStartNode is closed?
 			For a fixed start, processNode guarantees (I think) that,
 			for every destination, some node on the shortest path
 			to that destination remains open. */
 	}
-	{
-		Node& kDestNode = m_pNodeMap->get(m_kMap.plotNum(kDest));
-		if (!kDestNode.isState(PATHNODE_UNINITIALIZED))
-			m_pEndNode = &kDestNode;
-		/*	advc (note): If kDestNode is closed, then it could be that we've
-			been unable to move through it on a previous call, but, this time,
-			we only need to enter it, and isValidDest says that we can. */
-	}
-	if (bRecalcHeuristics)
-		recalculateHeuristics();
+	return bNewStartNode;
+}
 
+template<class StepMetric, class Node>
+void KmodPathFinder<StepMetric,Node>::generateReachMap(CvPlot const& kStart)
+{
+	PROFILE_FUNC();
+	m_pEndNode = NULL;
+	initStartNode(kStart); // (may reset m_iReachMapLength)
+	int const iMaxPath = m_stepMetric.getMaxPath();
+	if (m_iReachMapLength >= iMaxPath)
+		return;
+	/*	No destination, hence no heuristic. The open nodes may have heuristic
+		costs from an earlier generatePath call. */
+	m_pDest = NULL;
+	recalculateHeuristics();
+	m_openList.setMaxPath(iMaxPath);
 	while (processNode())
 	{
 		// nothing
 	}
-
-	if (m_pEndNode != NULL &&
-		(m_pEndNode->getPathLength() <= m_stepMetric.getMaxPath()))
-	{
-		return true;
-	}
-	return false;
+	m_iReachMapLength = iMaxPath;
 }
 
 template<class StepMetric, class Node>
@@ -522,47 +822,35 @@ void KmodPathFinder<StepMetric,Node>::resetNodes()
 		m_pNodeMap->reset();
 	m_openList.clear();
 	m_pEndNode = NULL;
+	m_iReachMapLength = -1; // advc.opt
 }
 
 template<class StepMetric, class Node>
 void KmodPathFinder<StepMetric,Node>::recalculateHeuristics()
 {
 	// Recalculate heuristic cost for all open nodes
-	for (OpenList::iterator it = m_openList.begin(); it != m_openList.end(); ++it)
+	for (typename OpenList::iterator it = m_openList.begin(); it != m_openList.end(); ++it)
 	{
 		Node& kNode = **it;
-		int iHeuristicCost = m_stepMetric.heuristicCost(
-				kNode.getPlot(), *m_pDest);
+		int iHeuristicCost = (m_pDest == NULL ? 0 : // advc.opt: see generateReachMap
+				m_stepMetric.heuristicCost(kNode.getPlot(), *m_pDest));
 		kNode.m_iHeuristicCost = iHeuristicCost;
 		kNode.m_iTotalCost = iHeuristicCost + kNode.m_iKnownCost;
 	}
+	m_openList.rebuild(); // advc.opt
 }
 
 template<class StepMetric, class Node>
 bool KmodPathFinder<StepMetric,Node>::processNode()
 {
-	OpenList::iterator itBest = m_openList.end();
-	{
-		int iLowestCost = (m_pEndNode != NULL ? m_pEndNode->m_iKnownCost : MAX_INT);
-		for (OpenList::iterator it = m_openList.begin(); it != m_openList.end(); ++it)
-		{
-			Node const& kNode = **it;
-			if (kNode.m_iTotalCost < iLowestCost &&
-				kNode.getPathLength() <= m_stepMetric.getMaxPath())
-			{
-				itBest = it;
-				iLowestCost = kNode.m_iTotalCost;
-			}
-		}
-	}
-
+	/*	advc.opt: Selection of the best node (and the max path check) moved
+		into the OpenList classes */
+	Node* pBest = m_openList.closeBest(
+			m_pEndNode != NULL ? m_pEndNode->m_iKnownCost : MAX_INT);
 	// If we didn't find a suitable node to process, then quit.
-	if (itBest == m_openList.end())
+	if (pBest == NULL)
 		return false;
-	Node& kParent = **itBest;
-	/*	Note: Needs to be done before pushing new entries,
-		otherwise the iterator will be invalid. */
-	m_openList.close(itBest);
+	Node& kParent = *pBest;
 	CvPlot const& kParentPlot = kParent.getPlot();
 
 	// Open a new node for each direction coming off the chosen node
@@ -579,11 +867,12 @@ bool KmodPathFinder<StepMetric,Node>::processNode()
 		{
 			// This path to the new node is valid. So we need to fill in the data.
 			//pathAdd(parent_node, child_node, ASNC_NEWADD, &settings, NULL); // K-Mod
+			m_pNodeMap->setTouched(kChild); // advc.opt
 			kChild.setPlot(*pChildPlot);
 			m_stepMetric.updatePathData(kChild, kParent);
 			kChild.m_iKnownCost = MAX_INT;
-			kChild.m_iHeuristicCost = m_stepMetric.heuristicCost(
-					*pChildPlot, *m_pDest);
+			kChild.m_iHeuristicCost = (m_pDest == NULL ? 0 : // advc.opt
+					m_stepMetric.heuristicCost(*pChildPlot, *m_pDest));
 			// Total cost will be set when the parent is set
 			if (m_stepMetric.canStepThrough(*pChildPlot, kChild))
 				m_openList.open(kChild);
@@ -655,6 +944,7 @@ bool KmodPathFinder<StepMetric,Node>::processNode()
 		FAssert(kChild.m_iNumChildren == 0 || !bNewNode);
 		forwardPropagate(kChild, iCostDelta);
 		FAssert(kChild.m_iKnownCost > kParent.m_iKnownCost);
+		m_openList.updateKey(kChild); // advc.opt
 	}
 	return true;
 }
@@ -697,6 +987,7 @@ void KmodPathFinder<StepMetric,Node>::forwardPropagate(Node& kHead, int iCostDel
 
 		kLoopChild.m_iKnownCost += iNewDelta;
 		kLoopChild.m_iTotalCost += iNewDelta;
+		m_openList.updateKey(kLoopChild); // advc.opt
 
 		FAssert(kLoopChild.m_iKnownCost > kHead.m_iKnownCost);
 		/*	advc: iNewDelta is never 0 here in tests. Often it's -4.
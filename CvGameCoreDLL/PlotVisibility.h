@@ -0,0 +1,117 @@
+#pragma once
+
+#ifndef PLOT_VISIBILITY_H
+#define PLOT_VISIBILITY_H
+
+/*	advc.opt: Per-team visibility counts and revealed flags of all plots. These
+	used to be EnumMaps at CvPlot, i.e. a heap allocation per plot for each of
+	them and a pointer to chase on each isVisible or isRevealed call. Now owned
+	by CvMap, which lets CvPlot access them through a static pointer so that the
+	CvPlot accessors can stay inline.
+	The revealed flags are bitplanes - one bit per plot and one plane per team -
+	so that map-wide operations can skip blocks of BLOCK_SIZE plots at once.
+	The counts are stored team by team, each team's counts contiguous in plot
+	order. Not serialized here; CvPlot::read and write still handle the data
+	of their plot (savegame format unchanged). */
+class PlotVisibility : private boost::noncopyable
+{
+public:
+	static int const BLOCK_SIZE = 32;
+
+	PlotVisibility() : m_iGridWidth(0), m_iPlots(0), m_iBlocks(0) {}
+
+	void init(int iGridWidth, int iPlots)
+	{
+		m_iGridWidth = iGridWidth;
+		m_iPlots = iPlots;
+		m_iBlocks = (iPlots + BLOCK_SIZE - 1) / BLOCK_SIZE;
+		m_aiVisibilityCount.assign(MAX_TEAMS * iPlots, 0);
+		m_aiStolenVisibilityCount.assign(MAX_TEAMS * iPlots, 0);
+		m_auiRevealed.assign(MAX_TEAMS * m_iBlocks, 0);
+	}
+
+	void uninit()
+	{
+		m_iGridWidth = m_iPlots = m_iBlocks = 0;
+		// Release the memory (clear wouldn't)
+		std::vector<short>().swap(m_aiVisibilityCount);
+		std::vector<short>().swap(m_aiStolenVisibilityCount);
+		std::vector<unsigned int>().swap(m_auiRevealed);
+	}
+
+	// Same as CvMap::plotNum
+	int plotNum(int iX, int iY) const
+	{
+		return iY * m_iGridWidth + iX;
+	}
+
+	int numBlocks() const { return m_iBlocks; }
+
+	int getVisibilityCount(TeamTypes eTeam, int iPlot) const
+	{
+		return m_aiVisibilityCount[countIndex(eTeam, iPlot)];
+	}
+	void setVisibilityCount(TeamTypes eTeam, int iPlot, int iNewValue)
+	{
+		m_aiVisibilityCount[countIndex(eTeam, iPlot)] = toShort(iNewValue);
+	}
+
+	int getStolenVisibilityCount(TeamTypes eTeam, int iPlot) const
+	{
+		return m_aiStolenVisibilityCount[countIndex(eTeam, iPlot)];
+	}
+	void setStolenVisibilityCount(TeamTypes eTeam, int iPlot, int iNewValue)
+	{
+		m_aiStolenVisibilityCount[countIndex(eTeam, iPlot)] = toShort(iNewValue);
+	}
+
+	bool isRevealed(TeamTypes eTeam, int iPlot) const
+	{
+		return ((m_auiRevealed[blockIndex(eTeam, iPlot / BLOCK_SIZE)] >>
+				(iPlot % BLOCK_SIZE)) & 1) != 0;
+	}
+	void setRevealed(TeamTypes eTeam, int iPlot, bool bNewValue)
+	{
+		unsigned int& uiBlock = m_auiRevealed[blockIndex(eTeam, iPlot / BLOCK_SIZE)];
+		unsigned int const uiBit = 1u << (iPlot % BLOCK_SIZE);
+		if (bNewValue)
+			uiBlock |= uiBit;
+		else uiBlock &= ~uiBit;
+	}
+	/*	Whether the revealed flags of all plots numbered
+		[iBlock * BLOCK_SIZE, (iBlock + 1) * BLOCK_SIZE) equal bValue.
+		(The block after the last plot counts as unrevealed.) */
+	bool isRevealedBlock(TeamTypes eTeam, int iBlock, bool bValue) const
+	{
+		unsigned int const uiBlock = m_auiRevealed[blockIndex(eTeam, iBlock)];
+		if (!bValue)
+			return (uiBlock == 0);
+		int const iPlotsInBlock = std::min(BLOCK_SIZE, m_iPlots - iBlock * BLOCK_SIZE);
+		unsigned int const uiMask = (iPlotsInBlock >= BLOCK_SIZE ? ~0u :
+				(1u << iPlotsInBlock) - 1);
+		return ((uiBlock & uiMask) == uiMask);
+	}
+
+private:
+	int m_iGridWidth;
+	int m_iPlots;
+	int m_iBlocks;
+	std::vector<short> m_aiVisibilityCount;
+	std::vector<short> m_aiStolenVisibilityCount;
+	std::vector<unsigned int> m_auiRevealed;
+
+	int countIndex(TeamTypes eTeam, int iPlot) const
+	{
+		FAssertBounds(0, MAX_TEAMS, eTeam);
+		FAssertBounds(0, m_iPlots, iPlot);
+		return eTeam * m_iPlots + iPlot;
+	}
+	int blockIndex(TeamTypes eTeam, int iBlock) const
+	{
+		FAssertBounds(0, MAX_TEAMS, eTeam);
+		FAssertBounds(0, m_iBlocks, iBlock);
+		return eTeam * m_iBlocks + iBlock;
+	}
+};
+
+#endif
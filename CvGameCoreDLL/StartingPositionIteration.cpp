@@ -18,6 +18,41 @@ using std::make_pair;
 
 //#define SPI_LOG // Enables log file for starting position iteration
 
+namespace
+{
+	/*	advc.opt: Wall time spent in each phase of the algorithm. (The phases
+		are also PROFILE sections, but game setup isn't usually profiled.) */
+	class PhaseTimer
+	{
+	public:
+		PhaseTimer()
+		{
+			LARGE_INTEGER freq;
+			QueryPerformanceFrequency(&freq);
+			m_iFrequency = freq.QuadPart;
+			m_iPhaseStart = now();
+		}
+		void endPhase(char const* szPhase)
+		{
+			LONGLONG const iNow = now();
+			m_out << szPhase << ": " << (int)((1000 * (iNow - m_iPhaseStart)) /
+					m_iFrequency) << " ms\n";
+			m_iPhaseStart = iNow;
+		}
+		std::string str() const { return m_out.str(); }
+	private:
+		LONGLONG m_iFrequency;
+		LONGLONG m_iPhaseStart;
+		std::ostringstream m_out;
+		static LONGLONG now()
+		{
+			LARGE_INTEGER time;
+			QueryPerformanceCounter(&time);
+			return time.QuadPart;
+		}
+	};
+}
+
 bool StartingPositionIteration::isDebug()
 {
 	#ifdef SPI_LOG
@@ -47,6 +82,7 @@ StartingPositionIteration::StartingPositionIteration() :
 	/*if (PlayerIter<CIV_ALIVE>::count() > 6 * GC.getGame().getRecommendedPlayers())
 		return;*/
 
+	PhaseTimer phaseTimer; // advc.opt
 	/*	Generate a starting site for each civ, starting with humans,
 		otherwise in a random order - just as CvGame::assignStartingPlots does.
 		Map scripts might depend on this order. If a map script sets the
@@ -127,11 +163,13 @@ StartingPositionIteration::StartingPositionIteration() :
 			return;
 		}
 	} // Past this point, we'll have set sensible starting plots; won't revert anymore.
+	phaseTimer.endPhase("Initial sites"); // advc.opt
 
 	// Precomputations (too costly to repeat in each iteration) ...
 
 	m_pEval = createSiteEvaluator();
 	PotentialSites potentialSiteGen(*m_pEval, m_bRestrictedAreas);
+	phaseTimer.endPhase("Potential sites"); // advc.opt
 	if (potentialSiteGen.numSites() < apCivPlayers.size())
 		return;
 	/*for (PlayerIter<CIV_ALIVE> it; it.hasNext(); ++it) // (debug) Mark original sites with a ruin
@@ -164,6 +202,7 @@ StartingPositionIteration::StartingPositionIteration() :
 		}
 		m_rMedianLandYieldVal = stats::median(arLandYields);
 	}
+	phaseTimer.endPhase("Yield values"); // advc.opt
 
 	DistanceTable const* pPathDists = NULL;
 	{	// Temp data that I want to go out of scope
@@ -189,6 +228,7 @@ StartingPositionIteration::StartingPositionIteration() :
 		}
 		gDLL->callUpdater(); // Dunno if these are needed or have any effect really
 		pPathDists = new DistanceTable(apPotentialSites, relevantPlots);
+		phaseTimer.endPhase("Distance table"); // advc.opt
 		gDLL->callUpdater();
 		// Remove the original sites again
 		for (size_t i = 0; i < apCivPlayers.size(); i++)
@@ -201,6 +241,7 @@ StartingPositionIteration::StartingPositionIteration() :
 	m_pPotentialSites = &potentialSiteGen;
 
 	doIterations(potentialSiteGen); // May modify the potential sites
+	phaseTimer.endPhase("Iterations"); // advc.opt
 
 	m_sitesPerTeam.resize(MAX_CIV_TEAMS);
 	if (GC.getGame().isTeamGame())
@@ -213,6 +254,12 @@ StartingPositionIteration::StartingPositionIteration() :
 					apCivPlayers[i]->getID());
 		}
 	}
+	// <advc.opt>
+	phaseTimer.endPhase("Team assignment");
+	#ifdef SPI_LOG
+		gDLL->logMsg("StartingPos.log", ("Time per phase:\n" + phaseTimer.str()).c_str(),
+				false, false);
+	#endif // </advc.opt>
 
 	delete pPathDists;
 	m_pPathDists = NULL;
@@ -270,6 +317,7 @@ StartingPositionIteration::PotentialSites::PotentialSites(
 	CitySiteEvaluator const& kEval, bool bRestrictedAreas) :
 	m_kEval(kEval)
 {
+	PROFILE_FUNC(); // advc.opt
 	for (PlayerIter<CIV_ALIVE> it; it.hasNext(); ++it)
 	{
 		m_sitesClosestToCurrSite.insert(make_pair(
@@ -560,6 +608,7 @@ void StartingPositionIteration::PotentialSites::getCurrFoundValues(
 StartingPositionIteration::DistanceTable::DistanceTable(
 	vector<CvPlot const*>& kSources, vector<CvPlot const*>& kDestinations)
 {
+	PROFILE_FUNC(); // advc.opt
 	scaled rStartEraFactor = 1;
 	if (GC.getNumEraInfos() > 1)
 	{
@@ -587,10 +636,30 @@ StartingPositionIteration::DistanceTable::DistanceTable(
 	}
 	m_distances.resize(kSources.size(),
 			vector<short>(kDestinations.size(), MAX_SHORT));
+	/*	<advc.opt> Which land plots can work a water destination doesn't depend
+		on the source, and canFound is costly. Store the candidates (and whether
+		they're in the inner ring) in CityPlotIter order. */
+	vector<vector<pair<CvPlot const*,bool> > > aaWaterDestWorkers(kDestinations.size());
+	for (size_t j = 0; j < kDestinations.size(); j++)
+	{
+		CvPlot const& kWaterDest = *kDestinations[j];
+		if (!kWaterDest.isWater())
+			continue;
+		for (CityPlotIter it(kWaterDest, false); it.hasNext(); ++it)
+		{
+			if (it->canFound())
+			{
+				aaWaterDestWorkers[j].push_back(make_pair(
+						&*it, it.currID() < NUM_INNER_PLOTS));
+			}
+		}
+	}
+	// Reused by all calls to computeDistances
+	vector<bool> abReached(kMap.numPlots()); // </advc.opt>
 	for (size_t i = 0; i < kSources.size(); i++)
 	{
 		CvPlot const& kSource = *kSources[i];
-		computeDistances(kSource);
+		computeDistances(kSource, abReached);
 		/*	Destinations can be (potential) city sites or workable tiles.
 			Water destinations are never city sites. To work a water tile,
 			no ships are needed, so the frontier penalties applied by
@@ -611,29 +680,29 @@ StartingPositionIteration::DistanceTable::DistanceTable(
 			short iShortestDist = MAX_SHORT;
 			bool bDest = false;
 			bool bInnerRing = false;
-			for (CityPlotIter it(kWaterDest, false); it.hasNext(); ++it)
+			vector<pair<CvPlot const*,bool> > const& kWorkers = aaWaterDestWorkers[j]; // advc.opt
+			for (size_t k = 0; k < kWorkers.size(); k++)
 			{
-				if (!it->canFound())
-					continue;
-				bool bInnerRingLoop = (it.currID() < NUM_INNER_PLOTS);
-				if (m_destinationIDs[kMap.plotNum(*it)] != NOT_A_DESTINATION)
+				CvPlot const& kLand = *kWorkers[k].first;
+				bool bInnerRingLoop = kWorkers[k].second;
+				if (m_destinationIDs[kMap.plotNum(kLand)] != NOT_A_DESTINATION)
 				{
-					short iDist = d(kSource, *it);
+					short iDist = d(kSource, kLand);
 					if (!bDest || iDist < iShortestDist)
 					{
 						bDest = true;
 						iShortestDist = iDist;
-						pNearestLand = &*it;
+						pNearestLand = &kLand;
 						bInnerRing = bInnerRingLoop;
 					}
 				}
-				else if (!bDest && it->sameArea(kSource))
+				else if (!bDest && kLand.sameArea(kSource))
 				{
-					short iDist = static_cast<short>(kMap.plotDistance(&kSource, &*it));
+					short iDist = static_cast<short>(kMap.plotDistance(&kSource, &kLand));
 					if (iDist < iShortestDist)
 					{
 						iShortestDist = iDist;
-						pNearestLand = &*it;
+						pNearestLand = &kLand;
 						bInnerRing = bInnerRingLoop;
 					}
 				}
@@ -700,7 +769,8 @@ namespace
 }
 
 
-void StartingPositionIteration::DistanceTable::computeDistances(CvPlot const& kSource)
+void StartingPositionIteration::DistanceTable::computeDistances(CvPlot const& kSource,
+	vector<bool>& abReached)
 {
 	CvMap const& kMap = GC.getMap();
 	bool const bSourceCoastal = kSource.isCoastalLand(-1);
@@ -708,8 +778,9 @@ void StartingPositionIteration::DistanceTable::computeDistances(CvPlot const& kS
 	std::priority_queue<Node> q;
 	q.push(Node(kSource, 0));
 	/*	Keep track of visited nodes in order to save time. Can't use m_distances
-		for this b/c it only contains destinations; may have to visit all plots. */
-	vector<bool> abReached(kMap.numPlots(), false);
+		for this b/c it only contains destinations; may have to visit all plots.
+		advc.opt: Buffer provided by the caller; only needs to be cleared. */
+	std::fill(abReached.begin(), abReached.end(), false);
 	while (!q.empty())
 	{
 		Node v = q.top();
@@ -860,6 +931,7 @@ StartingPositionIteration::SpaceEvaluator::SpaceEvaluator(
 	DistanceTable const& kDists, EnumMap<PlotNumTypes,scaled> const& kYieldValues,
 	bool bLog) : m_kDists(kDists), m_kYieldValues(kYieldValues), m_bLog(bLog)
 {
+	PROFILE_FUNC(); // advc.opt
 	CvMap const& kMap = GC.getMap();
 	// Treat distances beyond this threshold as infinite in order to save time
 	m_iDistThresh = (word)((5 * kDists.getLongDist()) / 4);
@@ -871,25 +943,37 @@ StartingPositionIteration::SpaceEvaluator::SpaceEvaluator(
 		instead of the starting city tile */
 	m_iDistSubtr = iAvgCityDist / 2;
 	word const iDistSubtr = m_iDistSubtr;
+	/*	<advc.opt> This loop runs for every step considered. Look up the rows
+		of the starting sites upfront rather than per plot and player. */
+	static vector<claim_t> const arInvDistCache = cacheInverseDistances(iDistThresh);
+	vector<pair<CvPlot const*,vector<short> const*> > aStartSiteDists;
+	for (PlayerIter<CIV_ALIVE> it; it.hasNext(); ++it)
+	{
+		CvPlot const& kStartPlot = *it->getStartingPlot();
+		DistanceTable::SourceID const eSrc = kDists.m_sourceIDs[kMap.plotNum(kStartPlot)];
+		FAssertBounds(0, kDists.m_distances.size(), eSrc);
+		aStartSiteDists.push_back(make_pair(&kStartPlot, &kDists.m_distances[eSrc]));
+	} // </advc.opt>
 	FOR_EACH_ENUM(PlotNum)
 	{
 		if (kYieldValues.get(eLoopPlotNum) <= 0)
 			continue;
+		CvPlot const& kLoopPlot = kMap.getPlotByIndex(eLoopPlotNum);
+		DistanceTable::DestinationID const eDst = kDists.m_destinationIDs[eLoopPlotNum];
+		FAssert(eDst != DistanceTable::NOT_A_DESTINATION);
 		claim_t rSum = 0;
-		for (PlayerIter<CIV_ALIVE> it; it.hasNext(); ++it)
+		for (size_t i = 0; i < aStartSiteDists.size(); i++)
 		{
-			CvPlot const& kStartPlot = *it->getStartingPlot();
-			CvPlot const& kLoopPlot = kMap.getPlotByIndex(eLoopPlotNum);
-			if (kMap.plotDistance(&kStartPlot, &kLoopPlot) <= 2)
+			if (kMap.plotDistance(aStartSiteDists[i].first, &kLoopPlot) <= 2)
 			{
 				// Accounted for by found values
 				m_sumOfClaims.set(eLoopPlotNum, 0);
 				goto next_plot;
 			}
-			short iDist = kDists.d(kStartPlot, kLoopPlot) - iDistSubtr;
+			short iDist = (*aStartSiteDists[i].second)[eDst] - iDistSubtr;
 			if (iDist > iDistThresh)
 				continue;
-			rSum += claim_t(1, std::max<short>(1, iDist));
+			rSum += arInvDistCache[std::max<short>(1, iDist)];
 		}
 		m_sumOfClaims.set(eLoopPlotNum, rSum);
 		next_plot: continue;
@@ -1040,6 +1124,17 @@ StartingPositionIteration::SpaceEvaluator::cacheDelayFactors(word iMaxDist)
 	return aResult;
 }
 
+/*	advc.opt: Claims of a single player, i.e. 1/iDist, for
+	iDist in [1, iMaxDist]. (Index 0 is unused.) */
+vector<StartingPositionIteration::SpaceEvaluator::claim_t>
+StartingPositionIteration::SpaceEvaluator::cacheInverseDistances(word iMaxDist)
+{
+	std::vector<claim_t> aResult(iMaxDist + 1);
+	for (word iDist = 1; iDist <= iMaxDist; iDist++)
+		aResult[iDist] = claim_t(1, iDist);
+	return aResult;
+}
+
 // The results are on the scale of AIFoundValue
 void StartingPositionIteration::computeStartValues(
 	EnumMap<PlayerTypes,short> const& kFoundValues, SolutionAttributes& kResult,
@@ -1781,6 +1876,7 @@ void StartingPositionIteration::logStep(Step const& kStep,
 
 void StartingPositionIteration::doIterations(PotentialSites& kPotentialSites)
 {
+	PROFILE_FUNC(); // advc.opt
 	evaluateCurrPosition(m_currSolutionAttribs, true);
 	m_bNormalizationTargetReady = true;
 
@@ -1946,6 +2042,7 @@ void StartingPositionIteration::doIterations(PotentialSites& kPotentialSites)
 
 void StartingPositionIteration::assignSitesToTeams()
 {
+	PROFILE_FUNC(); // advc.opt
 	vector<std::pair<int,TeamTypes> > aieTeamsBySize;
 	for (TeamIter<CIV_ALIVE> itTeam; itTeam.hasNext(); ++itTeam)
 		aieTeamsBySize.push_back(make_pair(itTeam->getNumMembers(), itTeam->getID()));
@@ -118,6 +118,7 @@ private:
 		TYPEDEF_SCALED_ENUM(1024*32, uint, claim_t);
 		void computeSpaceValue(PlayerTypes ePlayer);
 		static std::vector<claim_t> cacheDelayFactors(word iMaxDist);
+		static std::vector<claim_t> cacheInverseDistances(word iMaxDist); // advc.opt
 		DistanceTable const& m_kDists;
 		EnumMap<PlotNumTypes,scaled> const& m_kYieldValues;
 		EnumMap<PlayerTypes,scaled> m_spaceValues;
@@ -134,8 +135,9 @@ private:
 			the map dimensions */
 		enum SourceID { NOT_A_SOURCE = -1 };
 		enum DestinationID { NOT_A_DESTINATION = -1 };
-		// Needs to be able to traverse the table w/o having to go through all plots
-		friend void StartingPositionIteration::SpaceEvaluator::computeSpaceValue(PlayerTypes);
+		/*	Needs to be able to traverse the table w/o having to go through all plots
+			(advc.opt: and to look up the rows of the starting sites only once) */
+		friend class StartingPositionIteration::SpaceEvaluator;
 	public:
 		DistanceTable(std::vector<CvPlot const*>& kSources,
 				std::vector<CvPlot const*>& kDestinations);
@@ -153,7 +155,8 @@ private:
 		short m_iFirstFrontierCost;
 		short m_iSecondFrontierCost;
 
-		void computeDistances(CvPlot const& kSource);
+		void computeDistances(CvPlot const& kSource,
+				std::vector<bool>& abReached); // advc.opt: buffer param
 		void setDistance(CvPlot const& kSource, CvPlot const& kDestination,
 				short iDistance);
 		short stepDist(CvPlot const& kFrom, CvPlot const& kTo, bool bSourceCoastal) const;
@@ -12,17 +12,83 @@ static __declspec(naked)unsigned __int64 __cdecl RDTSC(void)
 	}
 }
 
-TSCSample::TSCSample(const char* szName)
-	: m_szName(szName)
-	, m_iStartTime(RDTSC())
+/*	advc.003o: Call tree of a single thread. Only accessed by its own thread
+	until writeFile merges the trees. */
+struct TSCThreadData
 {
+	struct Node
+	{
+		int iSampleId;
+		int iParent;
+		int iFirstChild;
+		int iNextSibling;
+		unsigned __int64 iCalls;
+		unsigned __int64 iTime; // inclusive
+		unsigned __int64 iChildTime;
+	};
+	std::vector<Node> aNodes; // Node 0 is the root
+	int iCurrent;
+
+	TSCThreadData() : iCurrent(0)
+	{
+		aNodes.reserve(256);
+		addNode(-1, -1);
+	}
+
+	int addNode(int iSampleId, int iParent)
+	{
+		Node kNode;
+		kNode.iSampleId = iSampleId;
+		kNode.iParent = iParent;
+		kNode.iFirstChild = -1;
+		kNode.iNextSibling = -1;
+		kNode.iCalls = 0;
+		kNode.iTime = 0;
+		kNode.iChildTime = 0;
+		aNodes.push_back(kNode);
+		return ((int)aNodes.size()) - 1;
+	}
+
+	// Returns the child of the current node for iSampleId; adds it if necessary.
+	int enter(int iSampleId)
+	{
+		int iChild = aNodes[iCurrent].iFirstChild;
+		while (iChild >= 0)
+		{
+			if (aNodes[iChild].iSampleId == iSampleId)
+				return iChild;
+			iChild = aNodes[iChild].iNextSibling;
+		}
+		iChild = addNode(iSampleId, iCurrent);
+		aNodes[iChild].iNextSibling = aNodes[iCurrent].iFirstChild;
+		aNodes[iCurrent].iFirstChild = iChild;
+		return iChild;
+	}
+};
+
+
+TSCSample::TSCSample(int& iId, char const* szName)
+{
+	TSCProfiler& kProfiler = TSCProfiler::getInstance();
+	if (iId < 0)
+		iId = kProfiler.registerSample(szName);
+	m_pThreadData = &kProfiler.getThreadData();
+	m_iParentNode = m_pThreadData->iCurrent;
+	m_pThreadData->iCurrent = m_pThreadData->enter(iId);
+	// Read the counter last and (in the destructor) first - to exclude the bookkeeping.
+	m_iStartTime = RDTSC();
 }
 
 TSCSample::~TSCSample()
 {
 	unsigned __int64 iTime = RDTSC();
 	iTime -= m_iStartTime;
-	TSCProfiler::getInstance().addSample(iTime, m_szName);
+	std::vector<TSCThreadData::Node>& kNodes = m_pThreadData->aNodes;
+	TSCThreadData::Node& kNode = kNodes[m_pThreadData->iCurrent];
+	kNode.iCalls++;
+	kNode.iTime += iTime;
+	kNodes[m_iParentNode].iChildTime += iTime;
+	m_pThreadData->iCurrent = m_iParentNode;
 }
 
 // <advc.003o>
@@ -30,41 +96,212 @@ TSCProfiler& TSCProfiler::getInstance()
 {
 	static TSCProfiler singleton;
 	return singleton;
-} // </advc.003o>
+}
+
 
-void TSCProfiler::addSample(unsigned __int64 iTime, const char* szName)
+TSCProfiler::TSCProfiler()
 {
-	SampleStorageTypes::iterator pIterator;
+	InitializeCriticalSection(&m_lock);
+	m_ulTlsIndex = TlsAlloc();
+	FAssert(m_ulTlsIndex != TLS_OUT_OF_INDEXES);
+}
+
+
+TSCProfiler::~TSCProfiler()
+{
+	for (size_t i = 0; i < m_apThreadData.size(); i++)
+		delete m_apThreadData[i];
+	TlsFree(m_ulTlsIndex);
+	DeleteCriticalSection(&m_lock);
+}
 
-	// TODO: make thread-safe without slowing down single threaded performance
 
-	pIterator = this->m_Samples.find(szName);
-	if (pIterator == m_Samples.end())
-		m_Samples.insert(std::pair <std::string, storage>( szName, storage(1, iTime)));
-	else
+int TSCProfiler::registerSample(char const* szName)
+{
+	/*	Another thread may have registered the same call site (or another site
+		with the same name) in the meantime. Samples with the same name share
+		an id, as they used to share a map entry. */
+	EnterCriticalSection(&m_lock);
+	int iId = -1;
+	for (size_t i = 0; i < m_aszSampleNames.size(); i++)
 	{
-		pIterator->second.first++;
-		pIterator->second.second += iTime;
+		if (strcmp(m_aszSampleNames[i], szName) == 0)
+		{
+			iId = (int)i;
+			break;
+		}
 	}
+	if (iId < 0)
+	{
+		iId = (int)m_aszSampleNames.size();
+		m_aszSampleNames.push_back(szName);
+	}
+	LeaveCriticalSection(&m_lock);
+	return iId;
+}
+
+
+TSCThreadData& TSCProfiler::getThreadData()
+{
+	TSCThreadData* pData = static_cast<TSCThreadData*>(TlsGetValue(m_ulTlsIndex));
+	if (pData != NULL)
+		return *pData;
+	pData = new TSCThreadData();
+	TlsSetValue(m_ulTlsIndex, pData);
+	EnterCriticalSection(&m_lock);
+	m_apThreadData.push_back(pData);
+	LeaveCriticalSection(&m_lock);
+	return *pData;
 }
 
+
+void TSCProfiler::mergeTree(TSCThreadData const& kThread, int iNode,
+	std::vector<MergedNode>& kMerged, int iMergedNode) const
+{
+	for (int iChild = kThread.aNodes[iNode].iFirstChild; iChild >= 0;
+		iChild = kThread.aNodes[iChild].iNextSibling)
+	{
+		TSCThreadData::Node const& kChild = kThread.aNodes[iChild];
+		int iMergedChild = -1;
+		std::vector<int> const& kSiblings = kMerged[iMergedNode].aiChildren;
+		for (size_t i = 0; i < kSiblings.size(); i++)
+		{
+			if (kMerged[kSiblings[i]].iSampleId == kChild.iSampleId)
+			{
+				iMergedChild = kSiblings[i];
+				break;
+			}
+		}
+		if (iMergedChild < 0)
+		{
+			MergedNode kNew;
+			kNew.iSampleId = kChild.iSampleId;
+			kNew.iCalls = 0;
+			kNew.iTime = 0;
+			kNew.iChildTime = 0;
+			iMergedChild = (int)kMerged.size();
+			kMerged.push_back(kNew); // (invalidates kSiblings)
+			kMerged[iMergedNode].aiChildren.push_back(iMergedChild);
+		}
+		kMerged[iMergedChild].iCalls += kChild.iCalls;
+		kMerged[iMergedChild].iTime += kChild.iTime;
+		kMerged[iMergedChild].iChildTime += kChild.iChildTime;
+		mergeTree(kThread, iChild, kMerged, iMergedChild);
+	}
+}
+
+/*	Inclusive time is only counted for the outermost call of a site on each
+	stack so that recursion doesn't count the same clocks repeatedly. */
+void TSCProfiler::sumSites(std::vector<MergedNode> const& kMerged, int iNode,
+	std::vector<int>& kOpenPerSite, std::vector<SiteTotals>& kTotals) const
+{
+	MergedNode const& kNode = kMerged[iNode];
+	int const iSite = kNode.iSampleId;
+	if (iSite >= 0)
+	{
+		SiteTotals& kSite = kTotals[iSite];
+		kSite.iCalls += kNode.iCalls;
+		kSite.iExclusiveTime += kNode.iTime - std::min(kNode.iTime, kNode.iChildTime);
+		if (kOpenPerSite[iSite] == 0)
+			kSite.iInclusiveTime += kNode.iTime;
+		kOpenPerSite[iSite]++;
+	}
+	for (size_t i = 0; i < kNode.aiChildren.size(); i++)
+		sumSites(kMerged, kNode.aiChildren[i], kOpenPerSite, kTotals);
+	if (iSite >= 0)
+		kOpenPerSite[iSite]--;
+}
+
+
+void TSCProfiler::writeTree(std::vector<MergedNode> const& kMerged, int iNode,
+	int iDepth, std::ostringstream& out) const
+{
+	MergedNode const& kNode = kMerged[iNode];
+	if (kNode.iSampleId >= 0)
+	{
+		out << std::string(2 * iDepth, ' ') << m_aszSampleNames[kNode.iSampleId]
+				<< "\t" << kNode.iCalls << "\t" << kNode.iTime << "\t"
+				<< (kNode.iTime - std::min(kNode.iTime, kNode.iChildTime)) << "\n";
+		iDepth++;
+	}
+	for (size_t i = 0; i < kNode.aiChildren.size(); i++)
+		writeTree(kMerged, kNode.aiChildren[i], iDepth, out);
+}
+
+
+void TSCProfiler::writeFolded(std::vector<MergedNode> const& kMerged, int iNode,
+	std::string const& szStack, std::ostringstream& out) const
+{
+	MergedNode const& kNode = kMerged[iNode];
+	std::string szPath(szStack);
+	if (kNode.iSampleId >= 0)
+	{
+		// ';' separates the frames
+		std::string szName(m_aszSampleNames[kNode.iSampleId]);
+		std::replace(szName.begin(), szName.end(), ';', ',');
+		if (!szPath.empty())
+			szPath += ";";
+		szPath += szName;
+		unsigned __int64 iExclusive = kNode.iTime - std::min(kNode.iTime, kNode.iChildTime);
+		if (iExclusive > 0)
+			out << szPath << " " << iExclusive << "\n";
+	}
+	for (size_t i = 0; i < kNode.aiChildren.size(); i++)
+		writeFolded(kMerged, kNode.aiChildren[i], szPath, out);
+} // </advc.003o>
+
+
 void TSCProfiler::writeFile() const
 {
-	if (m_Samples.empty())
+	// <advc.003o>
+	EnterCriticalSection(&m_lock);
+	std::vector<MergedNode> kMerged;
+	{
+		MergedNode kRoot;
+		kRoot.iSampleId = -1;
+		kRoot.iCalls = 0;
+		kRoot.iTime = 0;
+		kRoot.iChildTime = 0;
+		kMerged.push_back(kRoot);
+	}
+	for (size_t i = 0; i < m_apThreadData.size(); i++)
+		mergeTree(*m_apThreadData[i], 0, kMerged, 0);
+	if (kMerged.size() <= 1)
+	{
+		LeaveCriticalSection(&m_lock);
 		return;
+	}
+	std::vector<SiteTotals> kTotals(m_aszSampleNames.size());
+	for (size_t i = 0; i < kTotals.size(); i++)
+	{
+		kTotals[i].iCalls = 0;
+		kTotals[i].iInclusiveTime = 0;
+		kTotals[i].iExclusiveTime = 0;
+	}
+	std::vector<int> kOpenPerSite(m_aszSampleNames.size(), 0);
+	sumSites(kMerged, 0, kOpenPerSite, kTotals);
 
-	// <advc.003o>
 	std::ostringstream out;
-	out << "Name\t\tAverage clocks\tNumber of calls\tTotal clocks\n";
-	for (SampleStorageTypes::const_iterator iterator = m_Samples.begin(); iterator != m_Samples.end(); ++iterator)
+	out << "Name\t\tAverage clocks\tNumber of calls\tTotal clocks\tExclusive clocks\n";
+	for (size_t i = 0; i < kTotals.size(); i++)
 	{
-		unsigned __int64 iCount = iterator->second.first;
-		unsigned __int64 iTime = iterator->second.second;
-		out << iterator->first.c_str() << "\t" << (iTime / iCount) << "\t\t"
-				<< iCount << "\t" << iTime << "\n";
+		unsigned __int64 iCount = kTotals[i].iCalls;
+		if (iCount == 0)
+			continue;
+		unsigned __int64 iTime = kTotals[i].iInclusiveTime;
+		out << m_aszSampleNames[i] << "\t" << (iTime / iCount) << "\t\t"
+				<< iCount << "\t" << iTime << "\t" << kTotals[i].iExclusiveTime << "\n";
 	}
+	out << "\nCall tree (" << (int)m_apThreadData.size() << " thread(s))\n"
+			<< "Name\tNumber of calls\tTotal clocks\tExclusive clocks\n";
+	writeTree(kMerged, 0, 0, out);
 	out << std::endl;
 	gDLL->logMsg("TSCProfile.log", out.str().c_str(), false, false);
+
+	std::ostringstream folded;
+	writeFolded(kMerged, 0, "", folded);
+	gDLL->logMsg("TSCProfile.folded", folded.str().c_str(), false, false);
+	LeaveCriticalSection(&m_lock);
 	// </advc.003o>
 
 	/*CvString filename = gDLL->getModName();
@@ -4,41 +4,84 @@
 #define TSC_PROFILER_H
 
 /*  advc.003o: Profiler based on Time Stamp Counter. From the "We the People" mod
-	for Civ 4 Colonization. Original code by Nightinggale (3 Nov 2019). */
+	for Civ 4 Colonization. Original code by Nightinggale (3 Nov 2019).
+	Reworked so that the measurement overhead stays small: Each TSC_PROFILE site
+	registers its name only once and then refers to it through a static id.
+	Samples get aggregated in a call tree per thread (no locking after the first
+	sample of a thread), and the trees of all threads get merged in writeFile.
+	Output (Logs folder): TSCProfile.log with a flat table (inclusive and
+	exclusive clocks per site) and the call tree; TSCProfile.folded with one line
+	per call stack and the exclusive clocks spent in it ("collapsed stack" format
+	understood by flamegraph.pl and speedscope). */
 
 #ifdef USE_TSC_PROFILER
-#define TSC_PROFILE( x ) TSCSample sample( x );
+#define TSC_PROFILE( x ) \
+	static int iTSCSampleId__ = -1; \
+	TSCSample tscSample__(iTSCSampleId__, x);
 #else
 // advc.006c: void(0) in order to force semicolon
 #define TSC_PROFILE( x ) (void)0
 #endif
 
+struct TSCThreadData;
 
 class TSCSample // advc: Renamed from "Profiler"
 {
 public:
-	TSCSample(const char* szName);
+	/*	iId refers to a static variable at the call site; gets set upon
+		registration. szName needs to have static storage duration. */
+	TSCSample(int& iId, char const* szName);
 	~TSCSample();
 
 private:
-	const char* m_szName;
+	TSCThreadData* m_pThreadData;
+	int m_iParentNode;
 	unsigned __int64 m_iStartTime;
 };
 
 
-class TSCProfiler // advc: Renamed from "ProfilerManager"
+class TSCProfiler : private boost::noncopyable // advc: Renamed from "ProfilerManager"
 {
 public:
-	// advc.003o: Instead of an instance at CvGlobals
+	/*	advc.003o: Instead of an instance at CvGlobals. (Function-local static;
+		the first call needs to happen before any worker threads get started.) */
 	static TSCProfiler& getInstance();
-	void addSample(unsigned __int64 iTime, const char* szName);
+	int registerSample(char const* szName);
+	TSCThreadData& getThreadData();
 	void writeFile() const;
 
 private:
-	typedef std::pair<unsigned __int64, unsigned __int64> storage;
-	typedef stdext::hash_map< std::string, storage > SampleStorageTypes;
+	TSCProfiler();
+	~TSCProfiler();
 
-	SampleStorageTypes m_Samples;
+	struct MergedNode
+	{
+		int iSampleId;
+		std::vector<int> aiChildren;
+		unsigned __int64 iCalls;
+		unsigned __int64 iTime; // inclusive
+		unsigned __int64 iChildTime;
+	};
+	struct SiteTotals
+	{
+		unsigned __int64 iCalls;
+		unsigned __int64 iInclusiveTime;
+		unsigned __int64 iExclusiveTime;
+	};
+
+	std::vector<char const*> m_aszSampleNames; // indexed by sample id
+	std::vector<TSCThreadData*> m_apThreadData;
+	unsigned long m_ulTlsIndex;
+	mutable CRITICAL_SECTION m_lock;
+
+	void mergeTree(TSCThreadData const& kThread, int iNode,
+			std::vector<MergedNode>& kMerged, int iMergedNode) const;
+	void sumSites(std::vector<MergedNode> const& kMerged, int iNode,
+			std::vector<int>& kOpenPerSite, std::vector<SiteTotals>& kTotals) const;
+	void writeTree(std::vector<MergedNode> const& kMerged, int iNode, int iDepth,
+			std::ostringstream& out) const;
+	void writeFolded(std::vector<MergedNode> const& kMerged, int iNode,
+			std::string const& szStack, std::ostringstream& out) const;
 };
 
 #endif
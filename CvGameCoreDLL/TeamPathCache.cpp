@@ -0,0 +1,144 @@
+#include "CvGameCoreDLL.h"
+#include "TeamPathCache.h"
+#include "GroupPathFinder.h" // for minimumStepCost
+#include "CvTeam.h"
+
+// advc.opt: New implementation file; see comment in header.
+
+using namespace TeamPath;
+
+
+void TeamPathCache::init(TeamTypes eTeam)
+{
+	FAssert(eTeam != NO_TEAM);
+	m_eTeam = eTeam;
+	reset();
+}
+
+
+void TeamPathCache::reset()
+{
+	m_sources.clear();
+}
+
+
+int TeamPathCache::getPathCost(TeamPathFinder<LAND>& kPathFinder,
+	CvPlot const& kFrom, CvPlot const& kTo)
+{
+	return getPathCostImpl(kPathFinder, kFrom, kTo);
+}
+
+
+int TeamPathCache::getPathCost(TeamPathFinder<ANY_WATER>& kPathFinder,
+	CvPlot const& kFrom, CvPlot const& kTo)
+{
+	return getPathCostImpl(kPathFinder, kFrom, kTo);
+}
+
+
+int TeamPathCache::getPathCost(TeamPathFinder<SHALLOW_WATER>& kPathFinder,
+	CvPlot const& kFrom, CvPlot const& kTo)
+{
+	return getPathCostImpl(kPathFinder, kFrom, kTo);
+}
+
+
+template<Mode eMODE>
+int TeamPathCache::getPathCostImpl(TeamPathFinder<eMODE>& kPathFinder,
+	CvPlot const& kFrom, CvPlot const& kTo)
+{
+	TeamStepMetric<eMODE> const& kMetric = kPathFinder.getStepMetric();
+	FAssert(kMetric.getTeam().getID() == m_eTeam);
+	TeamTypes const eWarTarget = kMetric.getWarTarget().getID();
+	int const iMaxPath = kMetric.getMaxPath();
+	PlotNumTypes const eFrom = GC.getMap().plotNum(kFrom);
+	SourceMap::iterator itSource = m_sources.find(eFrom);
+	if (itSource != m_sources.end())
+	{
+		std::vector<Entry> const& aEntries = itSource->second.aEntries;
+		for (size_t i = 0; i < aEntries.size(); i++)
+		{
+			Entry const& kEntry = aEntries[i];
+			if (kEntry.pDest == &kTo && kEntry.eMode == eMODE &&
+				kEntry.eWarTarget == eWarTarget && kEntry.iMaxPath == iMaxPath)
+			{
+				return kEntry.iCost;
+			}
+		}
+	}
+	else
+	{
+		Source kNewSource;
+		kNewSource.pStart = &kFrom;
+		kNewSource.iMaxRadius = 0;
+		itSource = m_sources.insert(std::make_pair(eFrom, kNewSource)).first;
+	}
+	PROFILE("TeamPathCache - cache miss");
+	Entry kEntry;
+	kEntry.pDest = &kTo;
+	kEntry.iMaxPath = iMaxPath;
+	kEntry.eWarTarget = eWarTarget;
+	kEntry.eMode = eMODE;
+	if (kPathFinder.generatePath(kFrom, kTo))
+	{
+		kEntry.iCost = kPathFinder.getPathCost();
+		kEntry.iRadius = std::min(iMaxPath, kEntry.iCost / minStepCost(eMODE));
+	}
+	else
+	{
+		kEntry.iCost = -1;
+		kEntry.iRadius = iMaxPath;
+	}
+	Source& kSource = itSource->second;
+	kSource.aEntries.push_back(kEntry);
+	kSource.iMaxRadius = std::max(kSource.iMaxRadius, kEntry.iRadius);
+	return kEntry.iCost;
+}
+
+
+void TeamPathCache::onPlotChanged(CvPlot const& kPlot)
+{
+	CvMap const& kMap = GC.getMap();
+	for (SourceMap::iterator it = m_sources.begin(); it != m_sources.end(); ++it)
+	{
+		Source& kSource = it->second;
+		int const iStartDist = kMap.stepDistance(kSource.pStart, &kPlot);
+		if (iStartDist > kSource.iMaxRadius)
+			continue;
+		std::vector<Entry>& aEntries = kSource.aEntries;
+		int iMaxRadius = 0;
+		for (size_t i = 0; i < aEntries.size(); )
+		{
+			Entry const& kEntry = aEntries[i];
+			if (iStartDist + kMap.stepDistance(&kPlot, kEntry.pDest) <= kEntry.iRadius)
+			{	// Order of entries doesn't matter
+				aEntries[i] = aEntries.back();
+				aEntries.pop_back();
+			}
+			else
+			{
+				iMaxRadius = std::max(iMaxRadius, kEntry.iRadius);
+				i++;
+			}
+		}
+		kSource.iMaxRadius = iMaxRadius;
+	}
+}
+
+
+int TeamPathCache::size() const
+{
+	int iSize = 0;
+	for (SourceMap::const_iterator it = m_sources.begin(); it != m_sources.end(); ++it)
+		iSize += (int)it->second.aEntries.size();
+	return iSize;
+}
+
+/*	Lower bound for TeamStepMetric::cost. The route costs of the LAND metric
+	can't be lower than the admissible weight of the group pathfinder. */
+int TeamPathCache::minStepCost(Mode eMode)
+{
+	if (eMode == LAND)
+		return GroupPathFinder::minimumStepCost(1);
+	return GC.getMOVE_DENOMINATOR();
+}
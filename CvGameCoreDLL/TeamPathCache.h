@@ -0,0 +1,74 @@
+#pragma once
+
+#ifndef TEAM_PATH_CACHE_H
+#define TEAM_PATH_CACHE_H
+
+#include "TeamPathFinder.h"
+
+/*	advc.opt: Per-team memory of TeamPathFinder results, primarily for the
+	city-to-city distances computed by UWAICache::City::updateDistance every turn.
+	Entries are keyed by start, destination, mode, war target and max path length,
+	i.e. by everything that the TeamStepMetric depends on except for map and
+	diplomatic state. Changes to the diplomatic state of a team (war, borders,
+	vassal agreements, route techs) flush that team's cache; changes to a plot
+	only remove entries whose result could be affected by that plot.
+
+	A plot x can only affect the result of a search from s to t if some path
+	through x could be as cheap as the cached path and within the max path
+	length. Since every step costs at least minStepCost(mode), that means
+	stepDistance(s,x) + stepDistance(x,t) <= min(iMaxPath, iCost/minStepCost).
+	For failed searches only the max path length bounds the search region.
+	This keeps the cache consistent with what a new search would return
+	(up to the quirks of KmodPathFinder itself), so the cache doesn't need to be
+	stored in savegames and can't cause OOS errors after reloading.
+
+	Not copyable (b/c of the hash map member) and not serialized. */
+class TeamPathCache
+{
+public:
+	TeamPathCache() : m_eTeam(NO_TEAM) {}
+	void init(TeamTypes eTeam);
+	void reset();
+	/*	Cost of the path from kFrom to kTo, or -1 if kPathFinder finds no path.
+		kPathFinder needs to belong to the cache's team; it only gets used when
+		there is no cached result, and then has the same side effects as a
+		direct generatePath call. */
+	int getPathCost(TeamPathFinder<TeamPath::LAND>& kPathFinder,
+			CvPlot const& kFrom, CvPlot const& kTo);
+	int getPathCost(TeamPathFinder<TeamPath::ANY_WATER>& kPathFinder,
+			CvPlot const& kFrom, CvPlot const& kTo);
+	int getPathCost(TeamPathFinder<TeamPath::SHALLOW_WATER>& kPathFinder,
+			CvPlot const& kFrom, CvPlot const& kTo);
+	// Invalidation ...
+	void onPlotChanged(CvPlot const& kPlot);
+	inline void onTeamChanged() { reset(); } // diplomatic state or route techs
+	int size() const;
+
+private:
+	struct Entry
+	{
+		CvPlot const* pDest;
+		int iMaxPath;
+		int iCost; // -1 if no path
+		// Max. sum of step distances from start and dest that can affect iCost
+		int iRadius;
+		TeamTypes eWarTarget;
+		TeamPath::Mode eMode;
+	};
+	struct Source
+	{
+		CvPlot const* pStart;
+		std::vector<Entry> aEntries;
+		int iMaxRadius; // Upper bound (not necessarily tight) for all entries
+	};
+	typedef stdext::hash_map<PlotNumTypes,Source> SourceMap;
+	SourceMap m_sources;
+	TeamTypes m_eTeam;
+
+	template<TeamPath::Mode eMODE>
+	int getPathCostImpl(TeamPathFinder<eMODE>& kPathFinder,
+			CvPlot const& kFrom, CvPlot const& kTo);
+	static int minStepCost(TeamPath::Mode eMode);
+};
+
+#endif
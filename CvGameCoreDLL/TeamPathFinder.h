@@ -74,6 +74,9 @@ public:
 		return cost(kFrom, kTo); // disregard kParentNode
 	}
 	int cost(CvPlot const& kFrom, CvPlot const& kTo) const;
+	// <advc.opt> For TeamPathCache
+	inline CvTeam const& getTeam() const { return *m_pTeam; }
+	inline CvTeam const& getWarTarget() const { return *m_pWarTarget; } // </advc.opt>
 protected:
 	CvTeam const* m_pTeam;
 	CvTeam const* m_pWarTarget;
@@ -109,6 +112,11 @@ public:
 	{
 		return m_pEndNode->m_iTotalCost;
 	}
+	// <advc.opt> For TeamPathCache
+	inline TeamStepMetric<eMODE> const& getStepMetric() const
+	{
+		return m_stepMetric;
+	} // </advc.opt>
 protected:
 	CvTeam const* m_pTeam;
 	int m_iHeuristicWeight;
@@ -9,6 +9,7 @@
 #include "WarEvaluator.h"
 #include "CoreAI.h"
 #include "TeamPathFinder.h"
+#include "TeamPathCache.h" // advc.opt
 #include "CvSelectionGroupAI.h"
 #include "CityPlotIterator.h"
 #include "CvArea.h"
@@ -1402,6 +1403,7 @@ void UWAICache::City::updateDistance(CvCity const& targetCity, TeamPathFinders*
 	bool trainAnyCargo = cacheOwner.uwai().getCache().
 			canTrainAnyCargo();
 	int const seaPenalty = (human ? 2 : 4);
+	TeamPathCache& pathCache = GET_TEAM(cacheOwnerId).AI_pathCache(); // advc.opt
 	vector<int> pairwDurations;
 	/*  If we find no land path and no sea path from a city c to the target,
 		but at least one other city that does have a path to the target, then there
@@ -1417,10 +1419,13 @@ void UWAICache::City::updateDistance(CvCity const& targetCity, TeamPathFinders*
 		CvPlot* p = c->plot();
 		int pwd = MAX_INT; // pairwise (travel) duration
 		/*	Search from target to source. TeamStepMetric is symmetrical in that regard.
-			Doing it backwards allows intermediate results to be reused. */
-		if(pf->landFinder().generatePath(targetCity.getPlot(), *p)) {
-			pwd = intdiv::uround(pf->landFinder().getPathCost(),
-					GC.getMOVE_DENOMINATOR());
+			Doing it backwards allows intermediate results to be reused.
+			advc.opt: Path costs are memorized by the team's path cache;
+			the pathfinders only get used when the cache can't answer. */
+		int const landCost = pathCache.getPathCost(pf->landFinder(),
+				targetCity.getPlot(), *p);
+		if(landCost >= 0) {
+			pwd = intdiv::uround(landCost, GC.getMOVE_DENOMINATOR());
 			if(pwd == 0) // Make sure 0 is reserved for own cities
 				pwd = 1;
 			if(cacheOwner.AI_isPrimaryArea(c->getArea()))
@@ -1453,12 +1458,12 @@ void UWAICache::City::updateDistance(CvCity const& targetCity, TeamPathFinders*
 			if(transportDest != NULL) {
 				int d = -1;
 				if(trainDeepSeaCargo) {
-					if(pf->anyWaterFinder().generatePath(*transportDest, *p))
-						d = pf->anyWaterFinder().getPathCost();
+					d = pathCache.getPathCost(pf->anyWaterFinder(),
+							*transportDest, *p);
 				}
 				else {
-					if(pf->shallowWaterFinder().generatePath(*transportDest, *p))
-						d = pf->shallowWaterFinder().getPathCost();
+					d = pathCache.getPathCost(pf->shallowWaterFinder(),
+							*transportDest, *p);
 				}
 				if(d > 0) {
 					d = seaPenalty + intdiv::uround(d,
@@ -0,0 +1,341 @@
+// advc.opt: New file; see comment in header.
+
+#include "CvGameCoreDLL.h"
+#include "XMLBinaryCache.h"
+#include "FVariableSystem.h"
+#include <fstream>
+
+XMLBinaryCache::XMLBinaryCache(char const* szName)
+:	m_uiHash(2166136261u), // FNV-1a offset basis
+	m_uiPos(0), m_iEntries(0), m_bEnabled(true)
+{
+	m_szModPath = gDLL->getModName(true);
+	m_szFilePath = CvString::format("%s%s.bin", m_szModPath.c_str(), szName);
+	/*	Changes to the loading code should invalidate the cache too. Bumping
+		FORMAT_VERSION is easy to forget, so also use the size and modification
+		time of the DLL file. (The build time of any particular translation unit
+		wouldn't change when only the loading code in other files changes.) */
+	addModuleFile();
+}
+
+
+void XMLBinaryCache::addModuleFile()
+{
+	/*	The DLL's module handle is the allocation base of any of its static
+		data. (GetModuleHandle would need the file name, which mods may change.) */
+	static int const iAddressInModule = 0;
+	MEMORY_BASIC_INFORMATION memInfo;
+	if (VirtualQuery(&iAddressInModule, &memInfo, sizeof(memInfo)) == 0)
+	{
+		FAssertMsg(false, "Failed to locate the DLL module");
+		m_bEnabled = false;
+		return;
+	}
+	char szModulePath[MAX_PATH];
+	if (GetModuleFileNameA(static_cast<HMODULE>(memInfo.AllocationBase),
+		szModulePath, MAX_PATH) == 0)
+	{
+		FAssertMsg(false, "Failed to get the DLL's file name");
+		m_bEnabled = false;
+		return;
+	}
+	WIN32_FILE_ATTRIBUTE_DATA fileData;
+	if (!GetFileAttributesExA(szModulePath, GetFileExInfoStandard, &fileData))
+	{
+		FAssertMsg(false, "Failed to get the DLL's file attributes");
+		m_bEnabled = false;
+		return;
+	}
+	hash(&fileData.nFileSizeLow, sizeof(fileData.nFileSizeLow));
+	hash(&fileData.ftLastWriteTime, sizeof(fileData.ftLastWriteTime));
+}
+
+
+void XMLBinaryCache::hash(void const* pData, uint uiSize)
+{
+	byte const* pBytes = static_cast<byte const*>(pData);
+	for (uint i = 0; i < uiSize; i++)
+	{
+		m_uiHash ^= pBytes[i];
+		m_uiHash *= 16777619u; // FNV prime
+	}
+}
+
+
+void XMLBinaryCache::addKey(char const* szKey)
+{
+	hash(szKey, (uint)strlen(szKey) + 1);
+}
+
+
+void XMLBinaryCache::addKey(int iKey)
+{
+	hash(&iKey, sizeof(iKey));
+}
+
+
+bool XMLBinaryCache::addSourceFile(CvString const& szFile)
+{
+	addKey(szFile.c_str());
+	/*	Same lookup order as the EXE: mod folder, BtS folder, then the Warlords
+		and the original Civ4 folder (relative to the BtS folder). Files in
+		packed archives (or anywhere else) can't be checked; then the cache
+		gets disabled. */
+	char const* const aszFolders[] = {
+		m_szModPath.c_str(), "", "..\\Warlords\\", "..\\"
+	};
+	WIN32_FILE_ATTRIBUTE_DATA fileData;
+	for (int i = 0; i < ARRAY_LENGTH(aszFolders); i++)
+	{
+		CvString szPath(CvString::format("%sAssets\\%s", aszFolders[i], szFile.c_str()));
+		if (GetFileAttributesExA(szPath.c_str(), GetFileExInfoStandard, &fileData))
+		{
+			addKey(i); // A copy in another folder may have the same attributes
+			hash(&fileData.nFileSizeLow, sizeof(fileData.nFileSizeLow));
+			hash(&fileData.ftLastWriteTime, sizeof(fileData.ftLastWriteTime));
+			return true;
+		}
+	}
+	m_bEnabled = false;
+	return false;
+}
+
+
+bool XMLBinaryCache::readFile()
+{
+	if (!m_bEnabled)
+		return false;
+	std::ifstream file(m_szFilePath.c_str(), std::ios::in | std::ios::binary);
+	if (!file.good())
+		return false;
+	file.seekg(0, std::ios::end);
+	int const iSize = (int)file.tellg();
+	if (iSize <= 0)
+		return false;
+	file.seekg(0, std::ios::beg);
+	m_aBuffer.resize(iSize);
+	file.read(&m_aBuffer[0], iSize);
+	m_uiPos = 0;
+	uint uiVersion=0, uiHash=0;
+	if (!file || !get(uiVersion) || uiVersion != FORMAT_VERSION ||
+		!get(uiHash) || uiHash != m_uiHash)
+	{
+		m_aBuffer.clear();
+		return false;
+	}
+	return true;
+}
+
+
+void XMLBinaryCache::writeFile(int iHeaderValue)
+{
+	if (!m_bEnabled)
+	{
+		m_aBuffer.clear();
+		m_iEntries = 0;
+		return;
+	}
+	std::ofstream file(m_szFilePath.c_str(),
+			std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!file.good()) // E.g. no write access to the mod folder; nothing to be done.
+		return;
+	uint const uiVersion = FORMAT_VERSION;
+	file.write(reinterpret_cast<char const*>(&uiVersion), sizeof(uiVersion));
+	file.write(reinterpret_cast<char const*>(&m_uiHash), sizeof(m_uiHash));
+	file.write(reinterpret_cast<char const*>(&iHeaderValue), sizeof(iHeaderValue));
+	file.write(reinterpret_cast<char const*>(&m_iEntries), sizeof(m_iEntries));
+	if (!m_aBuffer.empty())
+		file.write(&m_aBuffer[0], (std::streamsize)m_aBuffer.size());
+	if (!file)
+	{	// Don't leave a truncated file behind (though the reader would cope)
+		file.close();
+		DeleteFileA(m_szFilePath.c_str());
+	}
+	m_aBuffer.clear();
+	m_iEntries = 0;
+}
+
+
+void XMLBinaryCache::putString(char const* szValue)
+{
+	uint const uiLength = (uint)strlen(szValue);
+	put(uiLength);
+	m_aBuffer.insert(m_aBuffer.end(), szValue, szValue + uiLength);
+}
+
+
+void XMLBinaryCache::putString(wchar const* szValue)
+{
+	uint const uiLength = (uint)wcslen(szValue);
+	put(uiLength);
+	char const* pData = reinterpret_cast<char const*>(szValue);
+	m_aBuffer.insert(m_aBuffer.end(), pData, pData + uiLength * sizeof(wchar));
+}
+
+
+bool XMLBinaryCache::getString(std::string& szValue)
+{
+	uint uiLength=0;
+	if (!get(uiLength) || m_uiPos + uiLength > m_aBuffer.size())
+		return false;
+	szValue.assign(uiLength == 0 ? "" : &m_aBuffer[m_uiPos], uiLength);
+	m_uiPos += uiLength;
+	return true;
+}
+
+
+bool XMLBinaryCache::getString(std::wstring& szValue)
+{
+	uint uiLength=0;
+	if (!get(uiLength) || m_uiPos + uiLength * sizeof(wchar) > m_aBuffer.size())
+		return false;
+	szValue.resize(uiLength);
+	if (uiLength > 0)
+		memcpy(&szValue[0], &m_aBuffer[m_uiPos], uiLength * sizeof(wchar));
+	m_uiPos += uiLength * sizeof(wchar);
+	return true;
+}
+
+
+bool XMLBinaryCache::readGlobalDefines(FVariableSystem& kDefines)
+{
+	PROFILE_FUNC();
+	int iHeaderValue=0, iEntries=0;
+	if (!readFile() || !get(iHeaderValue) || !get(iEntries))
+		return false;
+	std::string szName, szValue;
+	for (int i = 0; i < iEntries; i++)
+	{
+		int iType=-1;
+		bool bValid = (getString(szName) && get(iType));
+		switch (iType)
+		{
+		case FVARTYPE_BOOL:
+		{
+			bool bValue=false;
+			bValid = (bValid && get(bValue));
+			if (bValid)
+				kDefines.SetValue(szName.c_str(), bValue);
+			break;
+		}
+		case FVARTYPE_INT:
+		{
+			int iValue=0;
+			bValid = (bValid && get(iValue));
+			if (bValid)
+				kDefines.SetValue(szName.c_str(), iValue);
+			break;
+		}
+		case FVARTYPE_FLOAT:
+		{
+			float fValue=0;
+			bValid = (bValid && get(fValue));
+			if (bValid)
+				kDefines.SetValue(szName.c_str(), fValue);
+			break;
+		}
+		case FVARTYPE_STRING:
+			bValid = (bValid && getString(szValue));
+			if (bValid)
+				kDefines.SetValue(szName.c_str(), szValue.c_str());
+			break;
+		default: bValid = false;
+		}
+		if (!bValid)
+		{
+			FErrorMsg("GlobalDefines cache is corrupt");
+			m_aBuffer.clear();
+			return false;
+		}
+	}
+	m_aBuffer.clear();
+	return true;
+}
+
+
+void XMLBinaryCache::writeGlobalDefines(FVariableSystem& kDefines)
+{
+	PROFILE_FUNC();
+	m_aBuffer.clear();
+	m_iEntries = 0;
+	for (std::string szName = kDefines.GetFirstVariableName(); !szName.empty();
+		szName = kDefines.GetNextVariableName())
+	{
+		FVariable const& kVariable = *kDefines.GetVariable(szName.c_str());
+		// CvXMLLoadUtility::ReadGlobalDefines only creates these types
+		switch (kVariable.m_eType)
+		{
+		case FVARTYPE_BOOL:
+			putString(szName.c_str());
+			put((int)kVariable.m_eType);
+			put(kVariable.m_bValue);
+			break;
+		case FVARTYPE_INT:
+			putString(szName.c_str());
+			put((int)kVariable.m_eType);
+			put(kVariable.m_iValue);
+			break;
+		case FVARTYPE_FLOAT:
+			putString(szName.c_str());
+			put((int)kVariable.m_eType);
+			put(kVariable.m_fValue);
+			break;
+		case FVARTYPE_STRING:
+			putString(szName.c_str());
+			put((int)kVariable.m_eType);
+			putString(kVariable.m_szValue);
+			break;
+		default:
+			FErrorMsg("Type of global define not supported by cache");
+			continue;
+		}
+		m_iEntries++;
+	}
+	writeFile(0);
+}
+
+
+bool XMLBinaryCache::readGameText(int& iNumLanguages)
+{
+	PROFILE_FUNC();
+	int iEntries=0;
+	if (!readFile() || !get(iNumLanguages) || !get(iEntries))
+		return false;
+	std::string szId;
+	std::wstring szText, szGender, szPlural;
+	for (int i = 0; i < iEntries; i++)
+	{
+		if (!getString(szId) || !getString(szText) ||
+			!getString(szGender) || !getString(szPlural))
+		{
+			/*	The caller will have to load all text from XML, which overwrites
+				the entries added so far. */
+			FErrorMsg("GameText cache is corrupt");
+			m_aBuffer.clear();
+			return false;
+		}
+		gDLL->addText(szId.c_str(), szText.c_str(), szGender.c_str(), szPlural.c_str());
+	}
+	m_aBuffer.clear();
+	return true;
+}
+
+
+void XMLBinaryCache::recordText(char const* szId, wchar const* szText,
+	wchar const* szGender, wchar const* szPlural)
+{
+	if (!m_bEnabled)
+		return;
+	putString(szId);
+	putString(szText);
+	putString(szGender);
+	putString(szPlural);
+	m_iEntries++;
+}
+
+
+void XMLBinaryCache::writeGameText(int iNumLanguages)
+{
+	PROFILE_FUNC();
+	writeFile(iNumLanguages);
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#ifndef XML_BINARY_CACHE_H
+#define XML_BINARY_CACHE_H
+
+class FVariableSystem;
+
+/*	advc.opt: Binary copy of the data that CvXMLLoadUtility loads from the
+	GlobalDefines and GameText XML files, so that these files - the GameText
+	files in particular - don't have to be parsed on every launch. One file per
+	kind of data in the mod folder. Each file starts with a format version and
+	a hash of the inputs: the paths, sizes and modification times of the XML
+	files, any additional keys (e.g. the language) and the size and modification
+	time of the DLL file. If the hash doesn't match, the caller parses the XML
+	as usual and then rewrites the cache. If any of those files can't be
+	checked (e.g. packed in an FPK archive), the cache is neither read nor
+	written. Loading the cache is a single sequential read.
+	The info classes still get loaded from XML. Their read/write(FDataStreamBase*)
+	functions, meant for the EXE's XML cache (see ENABLE_XML_FILE_CACHE), don't
+	cover the data added by mods and are compiled out. */
+class XMLBinaryCache : private boost::noncopyable
+{
+public:
+	// szName: File name without extension
+	explicit XMLBinaryCache(char const* szName);
+	/*	Paths relative to the Assets folder, as passed to LoadCivXml.
+		Order matters. False if the file's size and modification time can't be
+		determined; the cache is then disabled. */
+	bool addSourceFile(CvString const& szFile);
+	void addKey(char const* szKey);
+	void addKey(int iKey);
+
+	/*	False if there is no up-to-date cache. (If the cache turns out to be
+		corrupt, some values may already have been set; parsing the XML
+		overwrites them.) */
+	bool readGlobalDefines(FVariableSystem& kDefines);
+	void writeGlobalDefines(FVariableSystem& kDefines);
+
+	/*	Passes all cached text entries to the EXE (CvDLLUtilityIFaceBase::addText).
+		False if there is no up-to-date cache. */
+	bool readGameText(int& iNumLanguages);
+	// Call for each entry in the order of the addText calls
+	void recordText(char const* szId, wchar const* szText,
+			wchar const* szGender, wchar const* szPlural);
+	void writeGameText(int iNumLanguages);
+
+private:
+	/*	Increment when changing the file layout or what the XML loading code
+		stores in the cached objects */
+	static uint const FORMAT_VERSION = 2;
+	CvString m_szModPath;
+	CvString m_szFilePath;
+	uint m_uiHash;
+	std::vector<char> m_aBuffer;
+	uint m_uiPos; // Read position in m_aBuffer
+	int m_iEntries; // Number of entries recorded for writing
+	bool m_bEnabled; // False if some input couldn't be checked
+
+	void hash(void const* pData, uint uiSize);
+	void addModuleFile();
+	bool readFile();
+	void writeFile(int iHeaderValue);
+
+	template<typename T>
+	void put(T tValue)
+	{
+		char const* pData = reinterpret_cast<char const*>(&tValue);
+		m_aBuffer.insert(m_aBuffer.end(), pData, pData + sizeof(T));
+	}
+	template<typename T>
+	bool get(T& tValue)
+	{
+		if (m_uiPos + sizeof(T) > m_aBuffer.size())
+			return false;
+		memcpy(&tValue, &m_aBuffer[m_uiPos], sizeof(T));
+		m_uiPos += sizeof(T);
+		return true;
+	}
+	void putString(char const* szValue);
+	void putString(wchar const* szValue);
+	bool getString(std::string& szValue);
+	bool getString(std::wstring& szValue);
+};
+
+#endif
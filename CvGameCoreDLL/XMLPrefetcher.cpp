@@ -0,0 +1,117 @@
+// advc.opt: New file; see comment in header.
+
+#include "CvGameCoreDLL.h"
+#include "XMLPrefetcher.h"
+
+HANDLE XMLPrefetcher::m_hThread = NULL;
+LONG volatile XMLPrefetcher::m_lStopRequested = 0;
+CvString XMLPrefetcher::m_szModXMLPath;
+
+namespace
+{
+	// Read granularity; the data gets discarded.
+	int const iBUFFER_SIZE = 64 * 1024;
+	char const* const szBTS_XML_PATH = "Assets\\XML";
+}
+
+
+void XMLPrefetcher::start()
+{
+	if (m_hThread != NULL)
+		return;
+	m_lStopRequested = 0;
+	CvString szModPath(gDLL->getModName(true));
+	// Empty when no mod is loaded; then only the BtS folder gets prefetched.
+	if (!szModPath.empty())
+		m_szModXMLPath = CvString::format("%sAssets\\XML", szModPath.c_str());
+	else m_szModXMLPath.clear();
+	DWORD dwThreadId = 0;
+	m_hThread = CreateThread(NULL, 0, &XMLPrefetcher::run, NULL, 0, &dwThreadId);
+	// Not an error; the XML just gets read without prefetching then.
+	FAssertMsg(m_hThread != NULL, "Failed to create XML prefetch thread");
+	if (m_hThread != NULL)
+		SetThreadPriority(m_hThread, THREAD_PRIORITY_BELOW_NORMAL);
+}
+
+
+void XMLPrefetcher::stop()
+{
+	if (m_hThread == NULL)
+		return;
+	InterlockedExchange(const_cast<LONG*>(&m_lStopRequested), 1);
+	WaitForSingleObject(m_hThread, INFINITE);
+	CloseHandle(m_hThread);
+	m_hThread = NULL;
+}
+
+
+DWORD WINAPI XMLPrefetcher::run(LPVOID pParam)
+{
+	std::vector<char> aBuffer(iBUFFER_SIZE);
+	CvString const szNoOverrides;
+	if (!m_szModXMLPath.empty())
+		prefetchFolder(m_szModXMLPath, szNoOverrides, aBuffer);
+	prefetchFolder(szBTS_XML_PATH, m_szModXMLPath, aBuffer);
+	return 0;
+}
+
+
+void XMLPrefetcher::prefetchFolder(CvString const& szFolder,
+	CvString const& szOverrideFolder, std::vector<char>& aBuffer)
+{
+	WIN32_FIND_DATAA findData;
+	HANDLE hFind = FindFirstFileA(CvString::format("%s\\*", szFolder.c_str()).c_str(),
+			&findData);
+	if (hFind == INVALID_HANDLE_VALUE)
+		return;
+	/*	Files before subfolders - the parser starts with the files at the top
+		(GlobalDefines, GlobalTypes etc.). */
+	std::vector<CvString> aszSubfolders;
+	do
+	{
+		if (isStopRequested())
+			break;
+		char const* szName = findData.cFileName;
+		if ((findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0)
+		{
+			if (strcmp(szName, ".") != 0 && strcmp(szName, "..") != 0 &&
+				_stricmp(szName, "Text") != 0)
+			{
+				aszSubfolders.push_back(szName);
+			}
+			continue;
+		}
+		size_t const uiLen = strlen(szName);
+		if (uiLen < 4 || _stricmp(szName + uiLen - 4, ".xml") != 0)
+			continue;
+		WIN32_FILE_ATTRIBUTE_DATA overrideData;
+		if (!szOverrideFolder.empty() && GetFileAttributesExA(CvString::format("%s\\%s",
+			szOverrideFolder.c_str(), szName).c_str(), GetFileExInfoStandard, &overrideData))
+		{
+			continue; // The parser will read the mod's version instead
+		}
+		prefetchFile(CvString::format("%s\\%s", szFolder.c_str(), szName), aBuffer);
+	} while (FindNextFileA(hFind, &findData));
+	FindClose(hFind);
+	for (size_t i = 0; i < aszSubfolders.size() && !isStopRequested(); i++)
+	{
+		prefetchFolder(CvString::format("%s\\%s", szFolder.c_str(), aszSubfolders[i].c_str()),
+				szOverrideFolder.empty() ? szOverrideFolder :
+				CvString::format("%s\\%s", szOverrideFolder.c_str(), aszSubfolders[i].c_str()),
+				aBuffer);
+	}
+}
+
+
+void XMLPrefetcher::prefetchFile(CvString const& szPath, std::vector<char>& aBuffer)
+{
+	HANDLE hFile = CreateFileA(szPath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+			OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (hFile == INVALID_HANDLE_VALUE)
+		return;
+	DWORD dwRead = 0;
+	while (!isStopRequested() &&
+		ReadFile(hFile, &aBuffer[0], (DWORD)aBuffer.size(), &dwRead, NULL) &&
+		dwRead > 0) {}
+	CloseHandle(hFile);
+}
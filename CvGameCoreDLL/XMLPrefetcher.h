@@ -0,0 +1,38 @@
+#pragma once
+
+#ifndef XML_PREFETCHER_H
+#define XML_PREFETCHER_H
+
+/*	advc.opt: Reads the XML files of the mod and of BtS on a worker thread while
+	CvXMLLoadUtility parses them on the main thread, so that the parser mostly
+	finds the files in the OS file cache. The parsing itself has to stay serial:
+	the EXE's XML interface (CvDLLXMLIFaceBase) and the type string registry
+	that the info classes use for resolving references (CvGlobals::
+	getInfoTypeForString) aren't thread-safe. The worker thread only calls Win32
+	file functions; it doesn't touch any game data and makes no gDLL calls.
+	Files in the mod folder come first; BtS files that the mod overrides get
+	skipped, and so does the Text folder (see XMLBinaryCache). */
+class XMLPrefetcher
+{
+public:
+	static void start(); // No-op if already started
+	/*	Tells the worker thread to stop and waits for it. Has to happen before
+		the DLL gets unloaded. */
+	static void stop();
+
+private:
+	static HANDLE m_hThread;
+	static LONG volatile m_lStopRequested;
+	// Set before the thread is created, read-only afterwards.
+	static CvString m_szModXMLPath;
+
+	static DWORD WINAPI run(LPVOID pParam);
+	static bool isStopRequested() { return (m_lStopRequested != 0); }
+	/*	szOverrideFolder: Corresponding folder in the mod; files that exist there
+		get skipped. Empty if there's nothing to skip. */
+	static void prefetchFolder(CvString const& szFolder,
+			CvString const& szOverrideFolder, std::vector<char>& aBuffer);
+	static void prefetchFile(CvString const& szPath, std::vector<char>& aBuffer);
+};
+
+#endif